@@ -0,0 +1,165 @@
+#ifndef MACHINE_DESCRIPTOR_H
+#define MACHINE_DESCRIPTOR_H
+
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+/*
+ * Memory hierarchy of the machine the tiled programs run on. These are
+ * passed to the models alongside the loop features so that a model trained
+ * on several machines can predict for any of them. Cache sizes are in KB,
+ * line sizes in bytes, and 0 means unknown
+ */
+struct MachineDescriptor {
+  long long l1dSizeKB = 0;
+  long long l1dLineSize = 0;
+  long long l1dAssoc = 0;
+  long long l2SizeKB = 0;
+  long long l2Assoc = 0;
+  long long llcSizeKB = 0;
+  long long llcAssoc = 0;
+  long long numCores = 0;
+
+  /*
+   * Pointers to every field, keyed by the field's feature name
+   */
+  std::map<std::string, long long*> fields() {
+    return {{"l1dSizeKB", &l1dSizeKB}, {"l1dLineSize", &l1dLineSize},
+            {"l1dAssoc", &l1dAssoc}, {"l2SizeKB", &l2SizeKB},
+            {"l2Assoc", &l2Assoc}, {"llcSizeKB", &llcSizeKB},
+            {"llcAssoc", &llcAssoc}, {"numCores", &numCores}};
+  }
+
+  /*
+   * Add the descriptor to a loop's feature map
+   */
+  void addToFeatures(std::map<std::string, long long> &features) {
+    for (const auto &pair : fields()) {
+      features[pair.first] = *pair.second;
+    }
+  }
+};
+
+/*
+ * Reads a single value from a sysfs file, or returns an empty string
+ */
+inline std::string readSysfsValue(const std::string &path) {
+  std::ifstream file(path);
+  std::string value;
+  if (file.is_open())
+    std::getline(file, value);
+  return value;
+}
+
+/*
+ * Converts a sysfs cache size (e.g. "32K" or "8M") to KB
+ */
+inline long long parseCacheSizeKB(const std::string &size) {
+  if (size.empty())
+    return 0;
+  long long value = atoll(size.c_str());
+  switch (size[size.size() - 1]) {
+    case 'M':
+      return value * 1024;
+    case 'G':
+      return value * 1024 * 1024;
+    case 'K':
+      return value;
+    default:
+      return value / 1024;
+  }
+}
+
+/*
+ * Describes the host from /sys/devices/system/cpu/cpu0/cache, where each
+ * indexN directory describes one cache level seen by cpu0
+ */
+inline MachineDescriptor readHostMachineDescriptor() {
+  MachineDescriptor desc;
+  const std::string cacheDir = "/sys/devices/system/cpu/cpu0/cache/index";
+  int llcLevel = 0;
+
+  for (int idx = 0; ; idx++) {
+    const std::string dir = cacheDir + std::to_string(idx) + "/";
+    const std::string levelStr = readSysfsValue(dir + "level");
+    if (levelStr.empty())
+      break;
+
+    int level = atoi(levelStr.c_str());
+    const std::string type = readSysfsValue(dir + "type");
+    if (type == "Instruction")
+      continue;
+
+    long long sizeKB = parseCacheSizeKB(readSysfsValue(dir + "size"));
+    long long lineSize = atoll(
+        readSysfsValue(dir + "coherency_line_size").c_str());
+    long long assoc = atoll(
+        readSysfsValue(dir + "ways_of_associativity").c_str());
+
+    if (level == 1) {
+      desc.l1dSizeKB = sizeKB;
+      desc.l1dLineSize = lineSize;
+      desc.l1dAssoc = assoc;
+    }
+    else if (level == 2) {
+      desc.l2SizeKB = sizeKB;
+      desc.l2Assoc = assoc;
+    }
+
+    // The last level cache is the highest level that holds data
+    if (level >= llcLevel) {
+      llcLevel = level;
+      desc.llcSizeKB = sizeKB;
+      desc.llcAssoc = assoc;
+    }
+  }
+
+  desc.numCores = sysconf(_SC_NPROCESSORS_ONLN);
+  return desc;
+}
+
+/*
+ * Reads a descriptor written by writeMachineDescriptor, so that programs can
+ * be tiled for a machine other than the host. Fields missing from the file
+ * are left as unknown
+ * @ret false if the file cannot be opened or contains an unknown field
+ */
+inline bool readMachineDescriptor(const std::string &path,
+                                  MachineDescriptor &desc) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Cannot open machine descriptor " << path << std::endl;
+    return false;
+  }
+
+  desc = MachineDescriptor();
+  std::map<std::string, long long*> fields = desc.fields();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::string::size_type eq = line.find('=');
+    std::string name = line.substr(0, eq);
+    if (eq == std::string::npos || !fields.count(name)) {
+      std::cerr << "Unknown machine descriptor field: " << line << std::endl;
+      return false;
+    }
+    *fields[name] = atoll(line.substr(eq + 1).c_str());
+  }
+  return true;
+}
+
+/*
+ * Writes a descriptor as name=value lines
+ */
+inline void writeMachineDescriptor(std::ostream &out, MachineDescriptor &desc) {
+  for (const auto &pair : desc.fields()) {
+    out << pair.first << "=" << *pair.second << "\n";
+  }
+}
+
+#endif /* MACHINE_DESCRIPTOR_H */
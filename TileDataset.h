@@ -0,0 +1,779 @@
+#ifndef TILE_DATASET_H
+#define TILE_DATASET_H
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+ * Append-only binary dataset of tiled program variants. It replaces
+ * features.csv and runtimes.csv with a single file holding the variant
+ * parameters, loop features, runtime statistics and hardware counters of
+ * every variant, keyed
+ * by an integer variant ID so that no string joins are needed.
+ *
+ * Layout (native byte order):
+ * - header: the magic "TSSDATA2", uint32 number of columns, then for each
+ *   column a uint8 type, uint16 width in bytes, uint16 name length and the
+ *   name, then the CRC-32 of the header
+ * - records: int64 variant ID followed by every column at its fixed width
+ *   and the CRC-32 of the record. Strings are NUL padded
+ *
+ * A variant can have several records, e.g. one from the generator and one
+ * per measurement. Records are merged by variant ID when read, later values
+ * replacing earlier ones and missing values (INT64_MIN, NaN or "") leaving
+ * them unchanged.
+ *
+ * Several processes can append to one dataset: the file is created
+ * atomically, and records are appended with one write() to a file opened
+ * with O_APPEND so they never interleave on a local filesystem. Records torn
+ * by a crash fail their CRC and are skipped when read. On filesystems
+ * without atomic appends (e.g. NFS), each worker writes its own dataset and
+ * the datasets are merged with mergeTileDatasets
+ */
+
+const char TILE_DATASET_MAGIC[8] = {'T', 'S', 'S', 'D', 'A', 'T', 'A', '2'};
+
+enum TileColumnType { TILE_INT64 = 0, TILE_DOUBLE = 1, TILE_STRING = 2 };
+
+const long long TILE_MISSING_INT = std::numeric_limits<long long>::min();
+
+struct TileColumn {
+  std::string name;
+  int type;
+  int width;
+};
+
+/*
+ * Values of one record. Columns that are absent are missing
+ */
+struct TileRecord {
+  long long variantId = 0;
+  std::map<std::string, long long> ints;
+  std::map<std::string, double> doubles;
+  std::map<std::string, std::string> strings;
+};
+
+/*
+ * CRC-32 (IEEE 802.3) of a buffer
+ */
+inline uint32_t getCrc32(const char *data, size_t size) {
+  static uint32_t table[256] = {0};
+  if (table[1] == 0) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+      }
+      table[i] = crc;
+    }
+  }
+
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ (unsigned char) data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+/*
+ * Variant ID of a variant name ({filename}_{lineNum}_{colNum}_{tileSize}),
+ * the 64 bit FNV-1a hash of the name
+ */
+inline long long getVariantId(const std::string &uniqueName) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : uniqueName) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return (long long) hash;
+}
+
+/*
+ * Columns describing a variant, written by the generator
+ */
+inline std::vector<TileColumn> getVariantColumns() {
+  return {{"uniqueFilename", TILE_STRING, 96},
+          {"rootFilename", TILE_STRING, 48},
+          {"dataset", TILE_STRING, 16},
+          {"lineNum", TILE_INT64, 8},
+          {"colNum", TILE_INT64, 8},
+          {"loopIdx", TILE_INT64, 8},
+          {"tileSize", TILE_INT64, 8}};
+}
+
+/*
+ * Runtime statistics of a variant, written by the measurements. Runtimes are
+ * in seconds
+ */
+const int TILE_DATASET_RUNS = 5;
+
+inline std::vector<TileColumn> getRuntimeColumns() {
+  std::vector<TileColumn> columns;
+  for (int run = 1; run <= TILE_DATASET_RUNS; run++) {
+    columns.push_back({"run" + std::to_string(run), TILE_DOUBLE, 8});
+  }
+  columns.push_back({"numRuns", TILE_INT64, 8});
+  columns.push_back({"meanRuntime", TILE_DOUBLE, 8});
+  columns.push_back({"minRuntime", TILE_DOUBLE, 8});
+  columns.push_back({"stddevRuntime", TILE_DOUBLE, 8});
+  // Mean time of one execution of the tiled loop nest alone, from the region
+  // timer of polybench.c (see --time-region) or the logs of instrumented
+  // programs (see TileDatasetTool ingest-log)
+  columns.push_back({"regionRuntime", TILE_DOUBLE, 8});
+  return columns;
+}
+
+/*
+ * Hardware counters of a run of a variant, read by polybench.c when it is
+ * compiled with POLYBENCH_PERF. Counters that are not available on the host
+ * are missing
+ */
+inline std::vector<TileColumn> getCounterColumns() {
+  return {{"cycles", TILE_INT64, 8},
+          {"instructions", TILE_INT64, 8},
+          {"l1dMisses", TILE_INT64, 8},
+          {"llcMisses", TILE_INT64, 8},
+          {"dtlbMisses", TILE_INT64, 8}};
+}
+
+/*
+ * How the runtimes of a variant were measured, as printed by polybench.c:
+ * the cache mode ("cold" or "warm") and the allocation policy of the arrays
+ * as pages/alignment/numa (e.g. "thp/2097152/interleave"), and by
+ * RunPinned: the CPU the runs were pinned to, its frequency governor and
+ * the turbo state ("on", "off" or "unknown")
+ */
+inline std::vector<TileColumn> getMeasurementColumns() {
+  return {{"cacheMode", TILE_STRING, 8},
+          {"allocPolicy", TILE_STRING, 40},
+          {"cpu", TILE_STRING, 8},
+          {"governor", TILE_STRING, 16},
+          {"turbo", TILE_STRING, 8}};
+}
+
+/*
+ * Noise estimate of the runs of a variant, from polybench.c: the
+ * preemptions of the program and its migrations to another CPU summed over
+ * the runs, and the mean fraction of the time the SMT siblings of its CPU
+ * were busy
+ */
+inline std::vector<TileColumn> getNoiseColumns() {
+  return {{"preemptions", TILE_INT64, 8},
+          {"migrations", TILE_INT64, 8},
+          {"siblingBusy", TILE_DOUBLE, 8}};
+}
+
+/*
+ * Schema of a new dataset: the variant columns, one int64 column per loop
+ * feature, then the runtime, counter, measurement and noise columns
+ */
+inline std::vector<TileColumn> getDatasetSchema(
+    const std::map<std::string, long long> &features) {
+  std::vector<TileColumn> schema = getVariantColumns();
+  for (const auto &pair : features) {
+    schema.push_back({pair.first, TILE_INT64, 8});
+  }
+  std::vector<TileColumn> runtimes = getRuntimeColumns();
+  schema.insert(schema.end(), runtimes.begin(), runtimes.end());
+  std::vector<TileColumn> counters = getCounterColumns();
+  schema.insert(schema.end(), counters.begin(), counters.end());
+  std::vector<TileColumn> measurement = getMeasurementColumns();
+  schema.insert(schema.end(), measurement.begin(), measurement.end());
+  std::vector<TileColumn> noise = getNoiseColumns();
+  schema.insert(schema.end(), noise.begin(), noise.end());
+  return schema;
+}
+
+/*
+ * @ret the size of a record of a schema in bytes, including its CRC
+ */
+inline size_t getRecordSize(const std::vector<TileColumn> &schema) {
+  size_t size = sizeof(long long) + sizeof(uint32_t);
+  for (const TileColumn &column : schema) {
+    size += column.width;
+  }
+  return size;
+}
+
+/*
+ * Encodes a schema as a dataset header
+ */
+inline std::string encodeSchema(const std::vector<TileColumn> &schema) {
+  std::string header(TILE_DATASET_MAGIC, sizeof(TILE_DATASET_MAGIC));
+  uint32_t numColumns = schema.size();
+  header.append((const char*) &numColumns, sizeof(numColumns));
+  for (const TileColumn &column : schema) {
+    uint8_t type = column.type;
+    uint16_t width = column.width;
+    uint16_t nameLength = column.name.size();
+    header.append((const char*) &type, sizeof(type));
+    header.append((const char*) &width, sizeof(width));
+    header.append((const char*) &nameLength, sizeof(nameLength));
+    header.append(column.name);
+  }
+  uint32_t crc = getCrc32(header.data(), header.size());
+  header.append((const char*) &crc, sizeof(crc));
+  return header;
+}
+
+/*
+ * Reads the header of a dataset, leaving the stream at the first record
+ * @ret false if the stream does not hold a dataset or its header is corrupt
+ */
+inline bool readSchema(std::istream &in, std::vector<TileColumn> &schema) {
+  char magic[sizeof(TILE_DATASET_MAGIC)];
+  uint32_t numColumns = 0;
+  if (!in.read(magic, sizeof(magic))
+      || memcmp(magic, TILE_DATASET_MAGIC, sizeof(magic)) != 0
+      || !in.read((char*) &numColumns, sizeof(numColumns)))
+    return false;
+
+  schema.clear();
+  for (uint32_t i = 0; i < numColumns; i++) {
+    uint8_t type = 0;
+    uint16_t width = 0;
+    uint16_t nameLength = 0;
+    if (!in.read((char*) &type, sizeof(type))
+        || !in.read((char*) &width, sizeof(width))
+        || !in.read((char*) &nameLength, sizeof(nameLength)))
+      return false;
+    std::string name(nameLength, '\0');
+    if (!in.read(&name[0], nameLength))
+      return false;
+    schema.push_back({name, type, width});
+  }
+
+  // The header is re-encoded to check its CRC
+  uint32_t crc = 0;
+  std::string header = encodeSchema(schema);
+  return in.read((char*) &crc, sizeof(crc))
+         && header.compare(header.size() - sizeof(crc), sizeof(crc),
+                           (const char*) &crc, sizeof(crc)) == 0;
+}
+
+/*
+ * Encodes a record onto out, filling columns absent from it with missing
+ * values. Nothing is encoded if the record is invalid
+ * @ret false if the record has a value that is not in the schema or a string
+ *      that does not fit its column
+ */
+inline bool encodeRecord(const std::vector<TileColumn> &schema,
+                         const TileRecord &record, std::string &out) {
+  size_t numValues = 0;
+  std::string encoded;
+  encoded.append((const char*) &record.variantId, sizeof(record.variantId));
+
+  for (const TileColumn &column : schema) {
+    if (column.type == TILE_INT64) {
+      auto iter = record.ints.find(column.name);
+      long long value = TILE_MISSING_INT;
+      if (iter != record.ints.end()) {
+        value = iter->second;
+        numValues++;
+      }
+      encoded.append((const char*) &value, sizeof(value));
+    }
+    else if (column.type == TILE_DOUBLE) {
+      auto iter = record.doubles.find(column.name);
+      double value = std::numeric_limits<double>::quiet_NaN();
+      if (iter != record.doubles.end()) {
+        value = iter->second;
+        numValues++;
+      }
+      encoded.append((const char*) &value, sizeof(value));
+    }
+    else {
+      auto iter = record.strings.find(column.name);
+      std::string value;
+      if (iter != record.strings.end()) {
+        value = iter->second;
+        numValues++;
+      }
+      if ((int) value.size() > column.width) {
+        std::cerr << "Value of " << column.name << " is longer than "
+                  << column.width << " bytes: " << value << std::endl;
+        return false;
+      }
+      value.resize(column.width, '\0');
+      encoded.append(value);
+    }
+  }
+
+  size_t numRecordValues = record.ints.size() + record.doubles.size() +
+                           record.strings.size();
+  if (numValues != numRecordValues) {
+    std::cerr << "Record has columns that are not in the dataset schema"
+              << std::endl;
+    return false;
+  }
+  uint32_t crc = getCrc32(encoded.data(), encoded.size());
+  encoded.append((const char*) &crc, sizeof(crc));
+  out.append(encoded);
+  return true;
+}
+
+/*
+ * Decodes a record, skipping missing values
+ * @ret false if the record fails its CRC
+ */
+inline bool decodeRecord(const std::vector<TileColumn> &schema,
+                         const char *data, TileRecord &record) {
+  uint32_t crc;
+  size_t size = getRecordSize(schema) - sizeof(crc);
+  memcpy(&crc, data + size, sizeof(crc));
+  if (crc != getCrc32(data, size))
+    return false;
+
+  memcpy(&record.variantId, data, sizeof(record.variantId));
+  data += sizeof(record.variantId);
+
+  for (const TileColumn &column : schema) {
+    if (column.type == TILE_INT64) {
+      long long value;
+      memcpy(&value, data, sizeof(value));
+      if (value != TILE_MISSING_INT)
+        record.ints[column.name] = value;
+    }
+    else if (column.type == TILE_DOUBLE) {
+      double value;
+      memcpy(&value, data, sizeof(value));
+      if (!std::isnan(value))
+        record.doubles[column.name] = value;
+    }
+    else {
+      std::string value(data, strnlen(data, column.width));
+      if (!value.empty())
+        record.strings[column.name] = value;
+    }
+    data += column.width;
+  }
+  return true;
+}
+
+/*
+ * Creates a dataset with a schema unless it already exists. The header is
+ * written to a temporary file that is linked into place, so concurrent
+ * writers never see a partial header
+ * @ret false if the dataset could not be created
+ */
+inline bool createTileDataset(const std::string &path,
+                              const std::vector<TileColumn> &schema) {
+  const std::string tmpPath = path + ".tmp." + std::to_string(getpid());
+  std::string header = encodeSchema(schema);
+  int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+  bool isWritten = write(fd, header.data(), header.size())
+                   == (ssize_t) header.size() && fsync(fd) == 0;
+  close(fd);
+
+  bool isCreated = isWritten
+                   && (link(tmpPath.c_str(), path.c_str()) == 0
+                       || errno == EEXIST);
+  unlink(tmpPath.c_str());
+  return isCreated;
+}
+
+/*
+ * Reads the records of a dataset. Records that fail their CRC and a torn
+ * record at the end of the file are skipped. After a corrupt record, the
+ * reader moves on byte by byte to the next offset whose record passes its
+ * CRC, so bytes left by a torn write do not shift the records after them
+ * @ret false if the dataset cannot be read
+ */
+inline bool readTileRecords(const std::string &path,
+                            std::vector<TileColumn> &schema,
+                            std::vector<TileRecord> &records) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open() || !readSchema(in, schema)) {
+    std::cerr << "Cannot read tile dataset " << path << std::endl;
+    return false;
+  }
+
+  const std::string data((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+  const size_t recordSize = getRecordSize(schema);
+  int numCorrupt = 0;
+  bool isSynced = true;
+  size_t pos = 0;
+  while (pos + recordSize <= data.size()) {
+    TileRecord record;
+    if (decodeRecord(schema, data.data() + pos, record)) {
+      records.push_back(record);
+      pos += recordSize;
+      isSynced = true;
+      continue;
+    }
+    // Count each run of corrupt bytes once
+    if (isSynced)
+      numCorrupt++;
+    isSynced = false;
+    pos++;
+  }
+  if (pos < data.size() && isSynced)
+    numCorrupt++;
+
+  if (numCorrupt > 0)
+    std::cerr << "Skipped " << numCorrupt << " corrupt records in " << path
+              << std::endl;
+  return true;
+}
+
+/*
+ * Buffered writer appending records to a dataset. The dataset is created
+ * with the schema of the first record's loop features if it does not exist.
+ * A record is the commit point of a variant: it is only appended once the
+ * variant's outputs are in place, so a variant without a record is redone
+ * when an interrupted sweep is restarted
+ */
+class TileDatasetWriter {
+ public:
+  explicit TileDatasetWriter(const std::string &path,
+                             size_t bufferSize = 1 << 20)
+      : path(path), bufferSize(bufferSize) {}
+
+  ~TileDatasetWriter() {
+    flush();
+    if (fd >= 0)
+      close(fd);
+  }
+
+  /*
+   * Appends a record. features are the loop features used for the schema
+   * when the dataset is created, and must already be in the record
+   * @ret false if the dataset cannot be opened or the record does not match
+   *      its schema
+   */
+  bool append(const TileRecord &record,
+              const std::map<std::string, long long> &features) {
+    if (fd < 0 && !openDataset(features))
+      return false;
+    if (!encodeRecord(schema, record, buffer))
+      return false;
+    recorded.insert(record.variantId);
+    if (buffer.size() >= bufferSize)
+      return flush();
+    return true;
+  }
+
+  /*
+   * Writes the buffered records to the dataset with a single write, and
+   * waits for them to reach the disk. Writers hold an exclusive lock on the
+   * dataset while they write, so a partial record at its end can only be
+   * left by a writer that crashed or failed: it is truncated before the
+   * records are appended, as is a failed write
+   */
+  bool flush() {
+    if (buffer.empty())
+      return true;
+    bool isWritten = fd >= 0 && flock(fd, LOCK_EX) == 0;
+    if (isWritten) {
+      off_t size = truncateTornRecord();
+      isWritten = size >= 0
+                  && write(fd, buffer.data(), buffer.size())
+                     == (ssize_t) buffer.size()
+                  && fdatasync(fd) == 0;
+      if (!isWritten && size >= 0 && ftruncate(fd, size) != 0)
+        std::cerr << "Cannot truncate tile dataset " << path << std::endl;
+      flock(fd, LOCK_UN);
+    }
+    if (!isWritten)
+      std::cerr << "Failed to write to tile dataset " << path << std::endl;
+    buffer.clear();
+    return isWritten;
+  }
+
+  /*
+   * @ret true if the dataset, or this writer, has a record of the variant
+   */
+  bool contains(long long variantId) {
+    if (!isLoaded) {
+      isLoaded = true;
+      std::vector<TileColumn> existingSchema;
+      std::vector<TileRecord> records;
+      std::ifstream in(path);
+      if (in.is_open() && readTileRecords(path, existingSchema, records)) {
+        for (const TileRecord &record : records) {
+          recorded.insert(record.variantId);
+        }
+      }
+    }
+    return recorded.count(variantId) > 0;
+  }
+
+  const std::vector<TileColumn> &getSchema() {
+    return schema;
+  }
+
+ private:
+  /*
+   * Opens the dataset for appending and reads its schema, creating it if it
+   * does not exist
+   */
+  bool openDataset(const std::map<std::string, long long> &features) {
+    if (!createTileDataset(path, getDatasetSchema(features))) {
+      std::cerr << "Cannot create tile dataset " << path << std::endl;
+      return false;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!readSchema(in, schema)) {
+      std::cerr << path << " is not a tile dataset" << std::endl;
+      return false;
+    }
+
+    headerSize = encodeSchema(schema).size();
+    fd = open(path.c_str(), O_WRONLY | O_APPEND);
+    return fd >= 0;
+  }
+
+  /*
+   * Truncates the dataset to its header and whole records, with the lock
+   * held
+   * @ret the size of the dataset, or -1 if it cannot be truncated
+   */
+  off_t truncateTornRecord() {
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < (off_t) headerSize)
+      return -1;
+    const off_t recordSize = getRecordSize(schema);
+    off_t size = headerSize
+                 + (status.st_size - headerSize) / recordSize * recordSize;
+    if (size != status.st_size && ftruncate(fd, size) != 0)
+      return -1;
+    return size;
+  }
+
+  std::string path;
+  size_t bufferSize;
+  int fd = -1;
+  std::vector<TileColumn> schema;
+  size_t headerSize = 0;
+  std::string buffer;
+  // Variants that have a record, loaded by contains
+  std::set<long long> recorded;
+  bool isLoaded = false;
+};
+
+/*
+ * Merges records by variant ID, in the order the variants first appear
+ */
+inline std::vector<TileRecord> mergeTileRecords(
+    const std::vector<TileRecord> &records) {
+  std::map<long long, size_t> variants;
+  std::vector<TileRecord> merged;
+
+  for (const TileRecord &record : records) {
+    auto iter = variants.find(record.variantId);
+    if (iter == variants.end()) {
+      variants[record.variantId] = merged.size();
+      merged.push_back(record);
+      continue;
+    }
+
+    TileRecord &variant = merged[iter->second];
+    for (const auto &pair : record.ints) {
+      variant.ints[pair.first] = pair.second;
+    }
+    for (const auto &pair : record.doubles) {
+      variant.doubles[pair.first] = pair.second;
+    }
+    for (const auto &pair : record.strings) {
+      variant.strings[pair.first] = pair.second;
+    }
+  }
+  return merged;
+}
+
+/*
+ * Reads a dataset and merges its records by variant ID
+ * @ret false if the dataset cannot be read
+ */
+inline bool readTileDataset(const std::string &path,
+                            std::vector<TileColumn> &schema,
+                            std::vector<TileRecord> &records) {
+  std::vector<TileRecord> allRecords;
+  if (!readTileRecords(path, schema, allRecords))
+    return false;
+  records = mergeTileRecords(allRecords);
+  return true;
+}
+
+/*
+ * Merges datasets with the same schema (e.g. per-worker datasets) into a
+ * new dataset with one record per variant. The output is written to a
+ * temporary file and renamed into place, so it is either complete or absent
+ * @ret false if a dataset cannot be read, the schemas differ, or the output
+ *      cannot be written
+ */
+inline bool mergeTileDatasets(const std::vector<std::string> &inPaths,
+                              const std::string &outPath) {
+  std::vector<TileColumn> schema;
+  std::vector<TileRecord> records;
+
+  for (const std::string &inPath : inPaths) {
+    std::vector<TileColumn> inSchema;
+    if (!readTileRecords(inPath, inSchema, records))
+      return false;
+    if (!schema.empty() && encodeSchema(schema) != encodeSchema(inSchema)) {
+      std::cerr << inPath << " has a different schema" << std::endl;
+      return false;
+    }
+    schema = inSchema;
+  }
+
+  std::string data = encodeSchema(schema);
+  for (const TileRecord &record : mergeTileRecords(records)) {
+    encodeRecord(schema, record, data);
+  }
+
+  const std::string tmpPath = outPath + ".tmp." + std::to_string(getpid());
+  std::ofstream out(tmpPath, std::ios::binary);
+  out.write(data.data(), data.size());
+  out.close();
+  if (!out.good() || rename(tmpPath.c_str(), outPath.c_str()) != 0) {
+    std::cerr << "Cannot write tile dataset " << outPath << std::endl;
+    unlink(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Writes merged records as CSV with a variantId column followed by the
+ * schema's columns. Missing values are left empty
+ */
+inline void writeTileDatasetCsv(std::ostream &out,
+                                const std::vector<TileColumn> &schema,
+                                const std::vector<TileRecord> &records) {
+  out << "variantId";
+  for (const TileColumn &column : schema) {
+    out << "," << column.name;
+  }
+  out << "\n";
+
+  char value[32];
+  for (const TileRecord &record : records) {
+    out << record.variantId;
+    for (const TileColumn &column : schema) {
+      out << ",";
+      if (column.type == TILE_INT64 && record.ints.count(column.name)) {
+        out << record.ints.at(column.name);
+      }
+      else if (column.type == TILE_DOUBLE
+               && record.doubles.count(column.name)) {
+        snprintf(value, sizeof(value), "%.9g", record.doubles.at(column.name));
+        out << value;
+      }
+      else if (column.type == TILE_STRING
+               && record.strings.count(column.name)) {
+        out << record.strings.at(column.name);
+      }
+    }
+    out << "\n";
+  }
+}
+
+/*
+ * A tiled loop of a dataset and the mean runtime of each of its measured
+ * tile sizes
+ */
+struct TileLoop {
+  // Output name of the loop's variants without their tile size
+  std::string loopId;
+  // Benchmark the loop is in, its file name without extension
+  std::string rootFilename;
+  // Every loop feature of the schema, -1 when unknown as in the passes
+  std::map<std::string, long long> features;
+  std::map<long long, double> runtimes;
+};
+
+/*
+ * @ret the loop features of a schema, its integer columns other than the
+ *      variant parameters, runtime statistics, hardware counters and noise
+ *      estimates
+ */
+inline std::set<std::string> getLoopFeatureNames(
+    const std::vector<TileColumn> &schema) {
+  std::set<std::string> nonFeatures;
+  for (const TileColumn &column : getVariantColumns()) {
+    nonFeatures.insert(column.name);
+  }
+  for (const TileColumn &column : getRuntimeColumns()) {
+    nonFeatures.insert(column.name);
+  }
+  for (const TileColumn &column : getCounterColumns()) {
+    nonFeatures.insert(column.name);
+  }
+  for (const TileColumn &column : getNoiseColumns()) {
+    nonFeatures.insert(column.name);
+  }
+  std::set<std::string> features;
+  for (const TileColumn &column : schema) {
+    if (column.type == TILE_INT64 && !nonFeatures.count(column.name))
+      features.insert(column.name);
+  }
+  return features;
+}
+
+/*
+ * Groups the tiled variants of merged records by loop, in the order the
+ * loops are first recorded, with the runtimes of runtimeColumn (e.g.
+ * regionRuntime for the time of the tiled nest alone). Loops without
+ * measured runtimes are included
+ */
+inline std::vector<TileLoop> getTileLoops(
+    const std::vector<TileColumn> &schema,
+    const std::vector<TileRecord> &records,
+    const std::string &runtimeColumn = "meanRuntime") {
+  const std::set<std::string> featureNames = getLoopFeatureNames(schema);
+  std::vector<TileLoop> loops;
+  std::map<std::string, size_t> loopIndex;
+  for (const TileRecord &record : records) {
+    auto tileSize = record.ints.find("tileSize");
+    auto name = record.strings.find("uniqueFilename");
+    if (tileSize == record.ints.end() || tileSize->second == 0
+        || name == record.strings.end())
+      continue;
+
+    const std::string loopId = name->second.substr(
+        0, name->second.find_last_of('_'));
+    auto iter = loopIndex.find(loopId);
+    if (iter == loopIndex.end()) {
+      TileLoop loop;
+      loop.loopId = loopId;
+      auto root = record.strings.find("rootFilename");
+      if (root != record.strings.end())
+        loop.rootFilename = root->second;
+      for (const std::string &feature : featureNames) {
+        auto value = record.ints.find(feature);
+        loop.features[feature] = value == record.ints.end() ? -1
+                                 : value->second;
+      }
+      iter = loopIndex.insert(std::make_pair(loopId, loops.size())).first;
+      loops.push_back(loop);
+    }
+
+    auto runtime = record.doubles.find(runtimeColumn);
+    if (runtime != record.doubles.end())
+      loops[iter->second].runtimes[tileSize->second] = runtime->second;
+  }
+  return loops;
+}
+
+#endif /* TILE_DATASET_H */
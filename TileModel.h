@@ -0,0 +1,297 @@
+#ifndef TILE_MODEL_H
+#define TILE_MODEL_H
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TileSearchSpace.h"
+
+/*
+ * Tree ensemble models trained by TrainTileModel and evaluated in-process by
+ * AutoTile. Every tree maps a feature vector to a vector of numOutputs
+ * values, and the model's scores are
+ *   baseline + scale * (sum of the trees' outputs)
+ * A classifier predicts the class with the highest score, e.g. the softmax
+ * logits of gradient boosting or the class frequencies of a random forest
+ * (whose scale is 1 / number of trees). A runtime model has a single output,
+ * the log runtime of a loop with a tile size relative to its fastest tile
+ * size, predicted from the loop's features and the tile size features of
+ * addTileSizeFeatures. It predicts the candidate tile size with the lowest
+ * score, so it can choose tile sizes it was never trained on.
+ *
+ * Text format:
+ *   tss-tile-model 1
+ *   kind {gbt|forest}
+ *   task {classify|runtime}
+ *   features {n} {name}...
+ *   classes {numOutputs} {tile size}...   (classes 0 for runtime models)
+ *   baseline {value}...
+ *   scale {value}
+ *   trees {n}
+ *   tree {number of nodes}
+ *   {feature index} {threshold} {left} {right} {value}...   (one per node)
+ * A node with feature index -1 is a leaf holding numOutputs values. Other
+ * nodes send a feature vector to left if its feature is <= threshold, and
+ * to right otherwise
+ */
+
+// Extension of model files in the text format, other models are evaluated
+// by predict_tile_size.py
+const std::string TILE_MODEL_EXTENSION = ".tssm";
+
+inline bool isTileModelPath(const std::string &path) {
+  return path.size() >= TILE_MODEL_EXTENSION.size()
+         && path.compare(path.size() - TILE_MODEL_EXTENSION.size(),
+                         TILE_MODEL_EXTENSION.size(),
+                         TILE_MODEL_EXTENSION) == 0;
+}
+
+/*
+ * Adds the features of tiling a loop with a tile size: the tile size, the
+ * number of tiles and the iterations of the partial last tile, from the
+ * tiled loop's tripCount (-1 when it is unknown)
+ */
+inline void addTileSizeFeatures(std::map<std::string, long long> &features,
+                                long long tileSize) {
+  auto tripCount = features.find("tripCount");
+  const bool isKnown = tripCount != features.end() && tripCount->second > 0;
+  features["tileSize"] = tileSize;
+  features["numTiles"] = isKnown
+                         ? (tripCount->second + tileSize - 1) / tileSize : -1;
+  features["tileRemainder"] = isKnown ? tripCount->second % tileSize : -1;
+}
+
+/*
+ * Tile sizes a runtime model chooses from by default, in the format of
+ * TileSearchSpace: the powers of two up to 256, then the other divisors of
+ * the tiled loop's trip count in that range (e.g. 40, 80 or 125 for 2000
+ * iterations), which leave no partial tile
+ */
+const std::string TILE_MODEL_CANDIDATES = "pow2:1-256,div:3-256";
+
+struct TileTreeNode {
+  int feature = -1;
+  double threshold = 0;
+  int left = -1;
+  int right = -1;
+  std::vector<double> values;
+};
+
+struct TileTree {
+  std::vector<TileTreeNode> nodes;
+
+  /*
+   * @ret the values of the leaf a feature vector falls into
+   */
+  const std::vector<double> &predict(const std::vector<double> &x) const {
+    int node = 0;
+    while (nodes[node].feature >= 0) {
+      node = x[nodes[node].feature] <= nodes[node].threshold
+             ? nodes[node].left : nodes[node].right;
+    }
+    return nodes[node].values;
+  }
+};
+
+struct TileModel {
+  std::string kind;
+  std::string task = "classify";
+  std::vector<std::string> featureNames;
+  // Tile size of each output of a classifier, empty for runtime models
+  std::vector<long long> classes;
+  std::vector<double> baseline;
+  double scale = 1;
+  std::vector<TileTree> trees;
+
+  int getNumOutputs() const {
+    return baseline.size();
+  }
+
+  /*
+   * @ret the scores of a feature vector ordered as featureNames
+   */
+  std::vector<double> predictScores(const std::vector<double> &x) const {
+    std::vector<double> scores(baseline);
+    for (const TileTree &tree : trees) {
+      const std::vector<double> &values = tree.predict(x);
+      for (size_t k = 0; k < scores.size(); k++) {
+        scores[k] += scale * values[k];
+      }
+    }
+    return scores;
+  }
+
+  /*
+   * Orders a feature map as featureNames
+   * @ret false if a feature the model needs is missing
+   */
+  bool getFeatureVector(const std::map<std::string, long long> &features,
+                        std::vector<double> &x) const {
+    x.clear();
+    for (const std::string &name : featureNames) {
+      auto iter = features.find(name);
+      if (iter == features.end()) {
+        std::cerr << "Missing feature for model: " << name << std::endl;
+        return false;
+      }
+      x.push_back(iter->second);
+    }
+    return true;
+  }
+
+  /*
+   * Predicts the tile size of a runtime model among candidates, the first
+   * one on ties
+   * @ret the candidate with the lowest predicted runtime, or 0 if a feature
+   *      is missing
+   */
+  long long predictBestCandidate(
+      const std::map<std::string, long long> &features,
+      const std::vector<long long> &candidates) const {
+    long long bestTileSize = 0;
+    double bestScore = 0;
+    std::map<std::string, long long> tiledFeatures(features);
+    std::vector<double> x;
+    for (long long tileSize : candidates) {
+      addTileSizeFeatures(tiledFeatures, tileSize);
+      if (!getFeatureVector(tiledFeatures, x))
+        return 0;
+      const double score = predictScores(x)[0];
+      if (bestTileSize == 0 || score < bestScore) {
+        bestTileSize = tileSize;
+        bestScore = score;
+      }
+    }
+    return bestTileSize;
+  }
+
+  /*
+   * @ret the tile size predicted for a loop's features, or 0 if a feature
+   *      is missing. Runtime models choose from candidates, or from
+   *      TILE_MODEL_CANDIDATES if it is empty
+   */
+  long long predictTileSize(
+      const std::map<std::string, long long> &features,
+      const TileSearchSpace &candidates = TileSearchSpace()) const {
+    if (task == "runtime" && candidates.empty()) {
+      TileSearchSpace defaultCandidates;
+      defaultCandidates.parse(TILE_MODEL_CANDIDATES);
+      return predictBestCandidate(features,
+                                  defaultCandidates.getTileSizes(features));
+    }
+    if (task == "runtime")
+      return predictBestCandidate(features, candidates.getTileSizes(features));
+
+    std::vector<double> x;
+    if (!getFeatureVector(features, x))
+      return 0;
+    std::vector<double> scores = predictScores(x);
+    size_t best = 0;
+    for (size_t k = 1; k < scores.size(); k++) {
+      if (scores[k] > scores[best])
+        best = k;
+    }
+    return classes[best];
+  }
+};
+
+/*
+ * Writes a model in the text format
+ */
+inline void writeTileModel(std::ostream &out, const TileModel &model) {
+  out.precision(17);
+  out << "tss-tile-model 1\n";
+  out << "kind " << model.kind << "\n";
+  out << "task " << model.task << "\n";
+  out << "features " << model.featureNames.size();
+  for (const std::string &name : model.featureNames) {
+    out << " " << name;
+  }
+  out << "\nclasses " << model.classes.size();
+  for (long long tileSize : model.classes) {
+    out << " " << tileSize;
+  }
+  out << "\nbaseline";
+  for (double value : model.baseline) {
+    out << " " << value;
+  }
+  out << "\nscale " << model.scale << "\n";
+  out << "trees " << model.trees.size() << "\n";
+  for (const TileTree &tree : model.trees) {
+    out << "tree " << tree.nodes.size() << "\n";
+    for (const TileTreeNode &node : tree.nodes) {
+      out << node.feature << " " << node.threshold << " " << node.left << " "
+          << node.right;
+      for (double value : node.values) {
+        out << " " << value;
+      }
+      out << "\n";
+    }
+  }
+}
+
+/*
+ * Reads a model in the text format
+ * @ret false if the file cannot be read or is not a model
+ */
+inline bool readTileModel(const std::string &path, TileModel &model) {
+  std::ifstream in(path);
+  std::string word;
+  int version = 0;
+  if (!(in >> word >> version) || word != "tss-tile-model" || version != 1) {
+    std::cerr << path << " is not a tile model" << std::endl;
+    return false;
+  }
+
+  model = TileModel();
+  size_t count = 0;
+  in >> word >> model.kind >> word >> model.task;
+  in >> word >> count;
+  model.featureNames.resize(count);
+  for (std::string &name : model.featureNames) {
+    in >> name;
+  }
+  in >> word >> count;
+  model.classes.resize(count);
+  for (long long &tileSize : model.classes) {
+    in >> tileSize;
+  }
+
+  // The baseline has one value per output
+  std::string line;
+  in >> word;
+  std::getline(in, line);
+  std::istringstream values(line);
+  double value;
+  while (values >> value) {
+    model.baseline.push_back(value);
+  }
+
+  in >> word >> model.scale >> word >> count;
+  model.trees.resize(count);
+  for (TileTree &tree : model.trees) {
+    size_t numNodes = 0;
+    in >> word >> numNodes;
+    tree.nodes.resize(numNodes);
+    for (TileTreeNode &node : tree.nodes) {
+      in >> node.feature >> node.threshold >> node.left >> node.right;
+      node.values.resize(model.getNumOutputs());
+      for (double &nodeValue : node.values) {
+        in >> nodeValue;
+      }
+    }
+  }
+
+  if (!in) {
+    std::cerr << "Truncated tile model " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+#endif /* TILE_MODEL_H */
@@ -0,0 +1,104 @@
+#ifndef TILE_PASS_H
+#define TILE_PASS_H
+
+#include "rose.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "MachineDescriptor.h"
+#include "TileDataset.h"
+#include "TileSearchSpace.h"
+
+/*
+ * Code shared by the tiling passes, AutoTile and GenerateTiledBenchmarks:
+ * loop normalization and nest transforms, loop features, pass options, and
+ * the generation of tiled variants. The functions are documented at their
+ * definitions in TilePass.C
+ */
+
+/*
+ * Options shared by the tiling passes. They are removed from the command
+ * line before it is handed to the ROSE frontend
+ */
+struct PassOptions {
+  // Machine the tiled programs run on (--machine=<descriptor file>)
+  MachineDescriptor machine;
+  // Number of dominating loop bodies to collect features for
+  // (--dominating-bodies=k)
+  int numBodies = 1;
+  // Run the loop normalization pre-pass (--normalize-loops=0|1)
+  bool normalizeLoops = true;
+  // Transformations from NEST_TRANSFORMS applied to loop nests before tiling
+  // (--nest-transforms=none,distribute,fuse)
+  std::vector<std::string> nestTransforms = {"none"};
+  // Tile dataset the variants are recorded in (--dataset=<path>)
+  std::string datasetPath = "dataset.tssd";
+  // Directory the tiled programs are moved to (--output-dir=<dir>)
+  std::string outputDir = ".";
+  // Skip variants that already have a record in the dataset, so that an
+  // interrupted run can be restarted (--skip-recorded=0|1). Only the sweeps
+  // of GenerateTiledBenchmarks default to it: a variant's name does not
+  // change with the source, so AutoTile must regenerate on every build
+  bool skipRecorded = false;
+  // Only generate the variants whose output names are listed in a file, one
+  // per line, e.g. the sizes chosen by autotune.sh (--variants=<file>)
+  bool filterVariants = false;
+  std::set<std::string> variants;
+  // Directory of the variant cache, disabled when empty
+  // (--variant-cache=<dir>)
+  std::string variantCache;
+  // Tile sizes searched for each loop, see TileSearchSpace.h
+  // (--tile-sizes=<spec> or --tile-sizes=@<file>)
+  TileSearchSpace tileSizes;
+  // Log the tiled programs append the time of their tiled loop nest to, no
+  // timing probes are emitted when empty (--instrument=<log>)
+  std::string instrumentLog;
+  // Time the tiled loop nest of each variant with polybench.c's region
+  // timer, reported next to the kernel's time (--time-region=0|1)
+  bool timeRegion = false;
+  // Digest of the command line and the sources it names, part of the key of
+  // every cached variant
+  std::string commandLineDigest;
+};
+
+/*
+ * Version of the tiling passes, part of the key of every cached variant.
+ * Increment it whenever a change to the passes changes the programs or
+ * features they generate
+ */
+const std::string PASS_VERSION = "2";
+
+// Loop nests
+int findNumberOfEnclosingLoops(SgNode* node);
+int findNumberOfEnclosedLoops(SgNode* node);
+std::map<SgInitializedName*, long long> estimateNestTripCounts(
+    SgForStatement* forLoop);
+void normalizeLoops(SgNode* root);
+int getNestTransformIndex(const std::string &transform);
+std::set<SgForStatement*> applyNestTransform(SgNode* root,
+                                             const std::string &transform);
+
+// Loop features
+bool collectLoopRefAndDist(SgForStatement* forLoop,
+                           std::map<std::string, long long> &refFeatures,
+                           int numBodies = 1);
+void printFeatures(std::map<std::string, long long> &features);
+
+// Pass options
+bool extractOption(int &argc, char *argv[], const std::string &name,
+                   std::string &value);
+bool parsePassOptions(int &argc, char *argv[], PassOptions &options);
+
+// Tiled variants
+std::string getVariantName(int argc, char *argv[], const std::string &fileName,
+                           int lineNum, int colNum, int loopIdx,
+                           const std::string &nestTransform, int tileSize);
+void generateTiledProg(int argc, char *argv[], std::string fileName,
+                       std::string funcName, int lineNum, int colNum,
+                       int loopIdx, const std::string &nestTransform,
+                       int tileSize, std::map<std::string, long long> &features,
+                       TileDatasetWriter &dataset, PassOptions &options);
+
+#endif /* TILE_PASS_H */
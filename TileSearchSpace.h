@@ -0,0 +1,172 @@
+#ifndef TILE_SEARCH_SPACE_H
+#define TILE_SEARCH_SPACE_H
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Tile sizes to search for a loop, from a spec of terms separated by commas
+ * or whitespace:
+ * - N: the tile size N
+ * - A-B or A-B:S: every S-th size from A to B (S defaults to 1), e.g.
+ *   24-40:4 to densify the search around 32
+ * - pow2:A-B: the powers of two from A to B
+ * - div:A-B: the divisors of the tiled loop's trip count (its tripCount
+ *   feature) from A to B, none when the trip count is unknown
+ * - @file: the terms of a file, in which # starts a comment
+ * Sizes are searched in the order they are first listed
+ */
+class TileSearchSpace {
+ public:
+  /*
+   * Adds the terms of a spec
+   * @ret false if a term is invalid or a file cannot be read
+   */
+  bool parse(const std::string &text) {
+    std::string separated(text);
+    for (char &c : separated) {
+      if (c == ',')
+        c = ' ';
+    }
+    std::istringstream words(separated);
+    std::string word;
+    while (words >> word) {
+      if (word[0] == '@') {
+        if (!parseFile(word.substr(1)))
+          return false;
+        continue;
+      }
+      Term term;
+      if (!parseTerm(word, term)) {
+        std::cerr << "Invalid tile size term: " << word << std::endl;
+        return false;
+      }
+      terms.push_back(term);
+      spec += (spec.empty() ? "" : ",") + word;
+    }
+    return true;
+  }
+
+  bool empty() const {
+    return terms.empty();
+  }
+
+  /*
+   * @ret the terms with files expanded, e.g. to key cached decisions
+   */
+  const std::string &getSpec() const {
+    return spec;
+  }
+
+  /*
+   * @ret the tile sizes to search for a loop with the given features
+   */
+  std::vector<long long> getTileSizes(
+      const std::map<std::string, long long> &features) const {
+    auto tripCountIter = features.find("tripCount");
+    const long long tripCount = tripCountIter == features.end()
+                                ? -1 : tripCountIter->second;
+
+    std::vector<long long> tileSizes;
+    std::set<long long> listed;
+    auto add = [&](long long tileSize) {
+      if (listed.insert(tileSize).second)
+        tileSizes.push_back(tileSize);
+    };
+    for (const Term &term : terms) {
+      for (long long size = term.first; size <= term.last;
+           size = term.isPow2 ? size * 2 : size + term.step) {
+        if (!term.isDivisor || (tripCount > 0 && tripCount % size == 0))
+          add(size);
+      }
+    }
+    return tileSizes;
+  }
+
+ private:
+  struct Term {
+    long long first = 1;
+    long long last = 1;
+    long long step = 1;
+    bool isPow2 = false;
+    bool isDivisor = false;
+  };
+
+  std::vector<Term> terms;
+  std::string spec;
+
+  // Sizes (and steps) are between 1 and 2^20
+  static bool parseNumber(const std::string &text, long long &value) {
+    char *end = nullptr;
+    value = strtoll(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && value >= 1 && value <= 1 << 20;
+  }
+
+  /*
+   * Parses "N", "A-B" or "A-B:S", optionally prefixed by "pow2:" or "div:"
+   */
+  static bool parseTerm(const std::string &word, Term &term) {
+    std::string range = word;
+    if (range.compare(0, 5, "pow2:") == 0) {
+      term.isPow2 = true;
+      range = range.substr(5);
+    }
+    else if (range.compare(0, 4, "div:") == 0) {
+      term.isDivisor = true;
+      range = range.substr(4);
+    }
+
+    std::string::size_type colon = range.find(':');
+    if (colon != std::string::npos) {
+      if (term.isPow2 || term.isDivisor
+          || !parseNumber(range.substr(colon + 1), term.step))
+        return false;
+      range = range.substr(0, colon);
+    }
+
+    std::string::size_type dash = range.find('-');
+    if (dash == std::string::npos) {
+      if (!parseNumber(range, term.first))
+        return false;
+      term.last = term.first;
+    }
+    else if (!parseNumber(range.substr(0, dash), term.first)
+             || !parseNumber(range.substr(dash + 1), term.last)) {
+      return false;
+    }
+    if (term.first > term.last)
+      return false;
+
+    // Powers of two start at the first one in the range
+    if (term.isPow2) {
+      long long size = 1;
+      while (size < term.first) {
+        size *= 2;
+      }
+      term.first = size;
+    }
+    return true;
+  }
+
+  bool parseFile(const std::string &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      std::cerr << "Cannot read tile sizes from " << path << std::endl;
+      return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+      if (!parse(line.substr(0, line.find('#'))))
+        return false;
+    }
+    return true;
+  }
+};
+
+#endif /* TILE_SEARCH_SPACE_H */
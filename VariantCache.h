@@ -0,0 +1,254 @@
+#ifndef VARIANT_CACHE_H
+#define VARIANT_CACHE_H
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Content-addressed cache of generated variants. An entry holds the tiled
+ * program, its binary and its loop features, and is keyed by a hash of
+ * everything that determines them: the contents of the source files and the
+ * headers they include, the command line, the compiler, the version of the
+ * pass and the transformation parameters. Rerunning a sweep after adding a
+ * benchmark or a tile size only generates and compiles the new variants.
+ *
+ * Layout: {dir}/{key}/program.c, program.out and features (name=value
+ * lines). Entries are published by renaming a complete temporary directory,
+ * so concurrent generators can share a cache
+ */
+
+/*
+ * 64 bit FNV-1a hash of a string, continuing from hash
+ */
+inline uint64_t hashBytes(const std::string &data,
+                          uint64_t hash = 14695981039346656037ULL) {
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+inline std::string hashToHex(uint64_t hash) {
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+  return hex;
+}
+
+/*
+ * Reads a whole file
+ * @ret false if the file cannot be read
+ */
+inline bool readFileContents(const std::string &path, std::string &contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  contents = buffer.str();
+  return true;
+}
+
+/*
+ * Copies a file through a temporary file renamed into place, keeping the
+ * permissions of the source
+ * @ret false if the file could not be copied
+ */
+inline bool copyFileAtomic(const std::string &from, const std::string &to) {
+  struct stat info;
+  if (stat(from.c_str(), &info) != 0)
+    return false;
+
+  const std::string tmpPath = to + ".tmp." + std::to_string(getpid());
+  {
+    std::ifstream in(from, std::ios::binary);
+    std::ofstream out(tmpPath, std::ios::binary);
+    out << in.rdbuf();
+    if (!in.good() || !out.good()) {
+      unlink(tmpPath.c_str());
+      return false;
+    }
+  }
+  chmod(tmpPath.c_str(), info.st_mode & 07777);
+  if (rename(tmpPath.c_str(), to.c_str()) != 0) {
+    unlink(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Adds the contents of a source file and of every file it includes to a
+ * hash. #include "..." is searched in the directory of the including file,
+ * then in includeDirs, and #include <...> in includeDirs only (e.g.
+ * <polybench.h> given -I to its utilities). Headers found in neither, the
+ * system headers, are covered by the compiler identity instead
+ */
+inline uint64_t hashSourceWithIncludes(
+    const std::string &path, const std::vector<std::string> &includeDirs,
+    uint64_t hash, std::set<std::string> &visited) {
+  std::string contents;
+  if (visited.count(path) || !readFileContents(path, contents))
+    return hash;
+  visited.insert(path);
+  hash = hashBytes(path + "\n" + contents, hash);
+
+  std::string::size_type slash = path.find_last_of('/');
+  std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+  std::vector<std::string> searchDirs(1, dir);
+  searchDirs.insert(searchDirs.end(), includeDirs.begin(), includeDirs.end());
+
+  std::istringstream lines(contents);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::string::size_type pos = line.find_first_not_of(" \t");
+    if (pos == std::string::npos || line[pos] != '#'
+        || line.find("include", pos) == std::string::npos)
+      continue;
+    std::string::size_type nameStart = line.find_first_of("\"<", pos);
+    if (nameStart == std::string::npos)
+      continue;
+    const bool isQuoted = line[nameStart] == '"';
+    std::string::size_type nameEnd = line.find(isQuoted ? '"' : '>',
+                                               nameStart + 1);
+    if (nameEnd == std::string::npos)
+      continue;
+
+    const std::string header = line.substr(nameStart + 1,
+                                           nameEnd - nameStart - 1);
+    for (const std::string &searchDir : isQuoted ? searchDirs : includeDirs) {
+      std::ifstream exists(searchDir + "/" + header);
+      if (exists.is_open()) {
+        hash = hashSourceWithIncludes(searchDir + "/" + header, includeDirs,
+                                      hash, visited);
+        break;
+      }
+    }
+  }
+  return hash;
+}
+
+/*
+ * Identity of the compiler that builds the variants: the output of
+ * "{compiler} --version"
+ */
+inline std::string getCompilerIdentity(const std::string &compiler) {
+  const std::string command = compiler + " --version 2>&1";
+  std::string identity;
+  FILE *pipe = popen(command.c_str(), "r");
+  if (pipe) {
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), pipe)) {
+      identity += buffer;
+    }
+    pclose(pipe);
+  }
+  return identity;
+}
+
+/*
+ * Digest of a compiler command line: every argument, the contents of the
+ * source files it names (with their includes, searched in the -I
+ * directories) and the identity of compiler, which builds the variants
+ */
+inline std::string getCommandLineDigest(int argc, char *argv[],
+                                        const std::string &compiler) {
+  std::vector<std::string> includeDirs;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, 2, "-I") == 0)
+      includeDirs.push_back(arg.substr(2));
+  }
+
+  uint64_t hash = hashBytes(getCompilerIdentity(compiler));
+  std::set<std::string> visited;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    hash = hashBytes(arg + "\n", hash);
+    if (arg[0] != '-')
+      hash = hashSourceWithIncludes(arg, includeDirs, hash, visited);
+  }
+  return hashToHex(hash);
+}
+
+/*
+ * Cache of variants in a directory, created when first stored to
+ */
+class VariantCache {
+ public:
+  explicit VariantCache(const std::string &dir) : dir(dir) {}
+
+  /*
+   * Copies a cached variant to {outPrefix}.c and {outPrefix}.out and reads
+   * its features
+   * @ret false if the variant is not cached
+   */
+  bool restore(const std::string &key, const std::string &outPrefix,
+               std::map<std::string, long long> &features) {
+    const std::string entry = dir + "/" + key + "/";
+    std::ifstream featureFile(entry + "features");
+    if (!featureFile.is_open())
+      return false;
+
+    features.clear();
+    std::string line;
+    while (std::getline(featureFile, line)) {
+      std::string::size_type eq = line.find('=');
+      if (eq != std::string::npos)
+        features[line.substr(0, eq)] = atoll(line.substr(eq + 1).c_str());
+    }
+
+    return copyFileAtomic(entry + "program.c", outPrefix + ".c")
+           && copyFileAtomic(entry + "program.out", outPrefix + ".out");
+  }
+
+  /*
+   * Stores a variant from its program, binary and features. The entry is
+   * built in a temporary directory and renamed into place, and an entry
+   * stored first by another generator is kept
+   * @ret false if the entry could not be written
+   */
+  bool store(const std::string &key, const std::string &programPath,
+             const std::string &binaryPath,
+             const std::map<std::string, long long> &features) {
+    mkdir(dir.c_str(), 0755);
+    const std::string entry = dir + "/" + key;
+    const std::string tmpEntry = entry + ".tmp." + std::to_string(getpid());
+    if (mkdir(tmpEntry.c_str(), 0755) != 0)
+      return false;
+
+    bool isWritten = copyFileAtomic(programPath, tmpEntry + "/program.c")
+                     && copyFileAtomic(binaryPath, tmpEntry + "/program.out");
+    {
+      std::ofstream featureFile(tmpEntry + "/features");
+      for (const auto &pair : features) {
+        featureFile << pair.first << "=" << pair.second << "\n";
+      }
+      isWritten = isWritten && featureFile.good();
+    }
+
+    if (!isWritten || rename(tmpEntry.c_str(), entry.c_str()) != 0) {
+      unlink((tmpEntry + "/program.c").c_str());
+      unlink((tmpEntry + "/program.out").c_str());
+      unlink((tmpEntry + "/features").c_str());
+      rmdir(tmpEntry.c_str());
+      return isWritten;
+    }
+    return true;
+  }
+
+ private:
+  std::string dir;
+};
+
+#endif /* VARIANT_CACHE_H */
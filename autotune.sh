@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# Model-guided tile size search: instead of measuring every tile size of the
+# search space, measure a few sizes per loop, then repeatedly let
+# AutoTuneTile pick the size with the highest expected improvement for each
+# loop, generate and measure those variants, until every loop has converged
+# or ROUNDS rounds have run. Sizes are generated with
+# generate_all_tiled_benchmarks.sh (DATASETS, JOBS etc. apply) and measured
+# with measure_runtimes.sh.
+#
+# INITIAL_SIZES are measured for every loop first. Arguments are passed to
+# AutoTuneTile, e.g. --budget=8 or --model=models/runtime_gbt.tssm to start
+# from a runtime model's predictions, and --tile-sizes=<spec> for the search
+# space (see TileSearchSpace.h)
+
+InitialSizes=${INITIAL_SIZES:-8,32,128}
+Rounds=${ROUNDS:-10}
+
+TILE_SIZES=$InitialSizes ./generate_all_tiled_benchmarks.sh
+./measure_runtimes.sh
+
+for round in $(seq $Rounds); do
+  ./AutoTuneTile "$@" tiled_polybench/dataset.tssd > tiled_polybench/autotune_next.txt || exit 1
+  if [ ! -s tiled_polybench/autotune_next.txt ]; then
+    break
+  fi
+  echo "Autotuning round $round: $(wc -l < tiled_polybench/autotune_next.txt) variants"
+
+  # The search space of every loop is the union of the chosen sizes, but
+  # only the chosen variants are generated and measured
+  TileSizes=$(sed 's/.*_//' tiled_polybench/autotune_next.txt | sort -nu | paste -sd, -)
+  VARIANTS=$PWD/tiled_polybench/autotune_next.txt TILE_SIZES=$TileSizes ./generate_all_tiled_benchmarks.sh
+  ./measure_runtimes.sh autotune_next.txt
+done
@@ -0,0 +1,127 @@
+/**
+ * batched-gemm.c: A batch of small matrix products, C[b] += A[b] * B[b],
+ * in the layout of a PolyBench 3.1 benchmark.
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+/* Default data type is double, default size is 2048x16x16x16. */
+#include "batched-gemm.h"
+
+
+/* Array initialization. */
+static
+void init_array(int nb, int ni, int nj, int nk,
+		DATA_TYPE *alpha,
+		DATA_TYPE POLYBENCH_3D(C,NB,NI,NJ,nb,ni,nj),
+		DATA_TYPE POLYBENCH_3D(A,NB,NI,NK,nb,ni,nk),
+		DATA_TYPE POLYBENCH_3D(B,NB,NK,NJ,nb,nk,nj))
+{
+  int b, i, j;
+
+  *alpha = 1.5;
+  for (b = 0; b < nb; b++)
+    {
+      for (i = 0; i < ni; i++)
+	for (j = 0; j < nj; j++)
+	  C[b][i][j] = (DATA_TYPE) ((b + i*j) % ni) / ni;
+      for (i = 0; i < ni; i++)
+	for (j = 0; j < nk; j++)
+	  A[b][i][j] = (DATA_TYPE) ((b*i + j) % nk) / nk;
+      for (i = 0; i < nk; i++)
+	for (j = 0; j < nj; j++)
+	  B[b][i][j] = (DATA_TYPE) ((b + i*(j+2)) % nj) / nj;
+    }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int nb, int ni, int nj,
+		 DATA_TYPE POLYBENCH_3D(C,NB,NI,NJ,nb,ni,nj))
+{
+  int b, i, j;
+
+  for (b = 0; b < nb; b++)
+    for (i = 0; i < ni; i++)
+      for (j = 0; j < nj; j++) {
+	fprintf (stderr, DATA_PRINTF_MODIFIER, C[b][i][j]);
+	if (((b * ni + i) * nj + j) % 20 == 0) fprintf (stderr, "\n");
+      }
+  fprintf (stderr, "\n");
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_batched_gemm(int nb, int ni, int nj, int nk,
+			 DATA_TYPE alpha,
+			 DATA_TYPE POLYBENCH_3D(C,NB,NI,NJ,nb,ni,nj),
+			 DATA_TYPE POLYBENCH_3D(A,NB,NI,NK,nb,ni,nk),
+			 DATA_TYPE POLYBENCH_3D(B,NB,NK,NJ,nb,nk,nj))
+{
+  int b, i, j, k;
+
+#pragma scop
+  for (b = 0; b < nb; b++)
+    for (i = 0; i < ni; i++)
+      for (k = 0; k < nk; k++)
+	for (j = 0; j < nj; j++)
+	  C[b][i][j] += alpha * A[b][i][k] * B[b][k][j];
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int nb = NB;
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  POLYBENCH_3D_ARRAY_DECL(C,DATA_TYPE,NB,NI,NJ,nb,ni,nj);
+  POLYBENCH_3D_ARRAY_DECL(A,DATA_TYPE,NB,NI,NK,nb,ni,nk);
+  POLYBENCH_3D_ARRAY_DECL(B,DATA_TYPE,NB,NK,NJ,nb,nk,nj);
+
+  /* Initialize array(s). */
+  init_array (nb, ni, nj, nk, &alpha,
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_batched_gemm (nb, ni, nj, nk, alpha,
+		       POLYBENCH_ARRAY(C),
+		       POLYBENCH_ARRAY(A),
+		       POLYBENCH_ARRAY(B));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(nb, ni, nj, POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+
+  return 0;
+}
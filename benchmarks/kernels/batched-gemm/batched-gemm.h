@@ -0,0 +1,60 @@
+/**
+ * batched-gemm.h: A batch of small matrix products, C[b] += A[b] * B[b],
+ * as in the batched BLAS of deep learning and finite element codes,
+ * in the layout of a PolyBench 3.1 benchmark.
+ */
+#ifndef BATCHED_GEMM_H
+# define BATCHED_GEMM_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(NB) && !defined(NI) && !defined(NJ) && !defined(NK)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define NB 8
+#   define NI 8
+#   define NJ 8
+#   define NK 8
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define NB 64
+#   define NI 16
+#   define NJ 16
+#   define NK 16
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define NB 2048
+#   define NI 16
+#   define NJ 16
+#   define NK 16
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define NB 4096
+#   define NI 32
+#   define NJ 32
+#   define NK 32
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define NB 16384
+#   define NI 32
+#   define NJ 32
+#   define NK 32
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+
+#endif /* !BATCHED_GEMM */
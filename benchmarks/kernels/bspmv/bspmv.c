@@ -0,0 +1,141 @@
+/**
+ * bspmv.c: A sparse matrix-vector product in the block compressed sparse
+ * row (BSR) format, y += A * x, in the layout of a PolyBench 3.1
+ * benchmark.
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+/* Default data type is double, default size is 4096x4096 blocks of 8x8,
+   16 per block row. */
+#include "bspmv.h"
+
+
+/* Array initialization. Block row i has BPR blocks spread over the block
+   columns, around the diagonal as in a banded or finite element matrix. */
+static
+void init_array(int nbr, int nbc, int bpr, int bs,
+		int POLYBENCH_1D(rowPtr,NBR+1,nbr+1),
+		int POLYBENCH_1D(colIdx,NNZB,nbr*bpr),
+		DATA_TYPE POLYBENCH_3D(val,NNZB,BS,BS,nbr*bpr,bs,bs),
+		DATA_TYPE POLYBENCH_2D(x,NBC,BS,nbc,bs),
+		DATA_TYPE POLYBENCH_2D(y,NBR,BS,nbr,bs))
+{
+  int i, j, r, c;
+
+  for (i = 0; i <= nbr; i++)
+    rowPtr[i] = i * bpr;
+  for (i = 0; i < nbr; i++)
+    for (j = 0; j < bpr; j++)
+      colIdx[i * bpr + j] = ((i + (j - bpr / 2) * (j % 2 ? 1 : 97)) % nbc
+			     + nbc) % nbc;
+  for (i = 0; i < nbr * bpr; i++)
+    for (r = 0; r < bs; r++)
+      for (c = 0; c < bs; c++)
+	val[i][r][c] = (DATA_TYPE) ((i + r * c + 1) % bs) / (bs * bpr);
+  for (i = 0; i < nbc; i++)
+    for (c = 0; c < bs; c++)
+      x[i][c] = (DATA_TYPE) ((i * bs + c) % 100) / 100;
+  for (i = 0; i < nbr; i++)
+    for (r = 0; r < bs; r++)
+      y[i][r] = 0;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int nbr, int bs,
+		 DATA_TYPE POLYBENCH_2D(y,NBR,BS,nbr,bs))
+{
+  int i, r;
+
+  for (i = 0; i < nbr; i++)
+    for (r = 0; r < bs; r++) {
+      fprintf (stderr, DATA_PRINTF_MODIFIER, y[i][r]);
+      if ((i * bs + r) % 20 == 0) fprintf (stderr, "\n");
+    }
+  fprintf (stderr, "\n");
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_bspmv(int nbr, int bs,
+		  int POLYBENCH_1D(rowPtr,NBR+1,nbr+1),
+		  int POLYBENCH_1D(colIdx,NNZB,NNZB),
+		  DATA_TYPE POLYBENCH_3D(val,NNZB,BS,BS,NNZB,bs,bs),
+		  DATA_TYPE POLYBENCH_2D(x,NBC,BS,NBC,bs),
+		  DATA_TYPE POLYBENCH_2D(y,NBR,BS,nbr,bs))
+{
+  int i, b, r, c;
+
+#pragma scop
+  for (i = 0; i < nbr; i++)
+    for (b = rowPtr[i]; b < rowPtr[i+1]; b++)
+      for (r = 0; r < bs; r++)
+	for (c = 0; c < bs; c++)
+	  y[i][r] += val[b][r][c] * x[colIdx[b]][c];
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int nbr = NBR;
+  int nbc = NBC;
+  int bpr = BPR;
+  int bs = BS;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_1D_ARRAY_DECL(rowPtr, int, NBR+1, nbr+1);
+  POLYBENCH_1D_ARRAY_DECL(colIdx, int, NNZB, nbr*bpr);
+  POLYBENCH_3D_ARRAY_DECL(val, DATA_TYPE, NNZB, BS, BS, nbr*bpr, bs, bs);
+  POLYBENCH_2D_ARRAY_DECL(x, DATA_TYPE, NBC, BS, nbc, bs);
+  POLYBENCH_2D_ARRAY_DECL(y, DATA_TYPE, NBR, BS, nbr, bs);
+
+  /* Initialize array(s). */
+  init_array (nbr, nbc, bpr, bs,
+	      POLYBENCH_ARRAY(rowPtr),
+	      POLYBENCH_ARRAY(colIdx),
+	      POLYBENCH_ARRAY(val),
+	      POLYBENCH_ARRAY(x),
+	      POLYBENCH_ARRAY(y));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_bspmv (nbr, bs,
+		POLYBENCH_ARRAY(rowPtr),
+		POLYBENCH_ARRAY(colIdx),
+		POLYBENCH_ARRAY(val),
+		POLYBENCH_ARRAY(x),
+		POLYBENCH_ARRAY(y));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(nbr, bs, POLYBENCH_ARRAY(y)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(rowPtr);
+  POLYBENCH_FREE_ARRAY(colIdx);
+  POLYBENCH_FREE_ARRAY(val);
+  POLYBENCH_FREE_ARRAY(x);
+  POLYBENCH_FREE_ARRAY(y);
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * bspmv.h: A sparse matrix-vector product in the block compressed
+ * sparse row (BSR) format, with dense BS x BS blocks and BPR blocks in
+ * each block row, as in finite element and graph codes,
+ * in the layout of a PolyBench 3.1 benchmark.
+ */
+#ifndef BSPMV_H
+# define BSPMV_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(NBR) && !defined(NBC) && !defined(BPR) && !defined(BS)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define NBR 32
+#   define NBC 32
+#   define BPR 4
+#   define BS 4
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define NBR 256
+#   define NBC 256
+#   define BPR 8
+#   define BS 4
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define NBR 4096
+#   define NBC 4096
+#   define BPR 16
+#   define BS 8
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define NBR 16384
+#   define NBC 16384
+#   define BPR 16
+#   define BS 8
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define NBR 32768
+#   define NBC 32768
+#   define BPR 16
+#   define BS 8
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+/* Number of nonzero blocks. */
+# define NNZB (NBR*BPR)
+
+
+#endif /* !BSPMV */
@@ -0,0 +1,116 @@
+/**
+ * conv-2d.c: A 2D convolution of an image with a square filter,
+ * in the layout of a PolyBench 3.1 benchmark.
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+/* Default data type is double, default size is 1024x1024x5. */
+#include "conv-2d.h"
+
+
+/* Array initialization. The input image has a border of K-1 pixels, so
+   that every output pixel has a full window. */
+static
+void init_array (int h, int w, int k,
+		 DATA_TYPE POLYBENCH_2D(in,H+K-1,W+K-1,h+k-1,w+k-1),
+		 DATA_TYPE POLYBENCH_2D(filter,K,K,k,k),
+		 DATA_TYPE POLYBENCH_2D(out,H,W,h,w))
+{
+  int i, j;
+
+  for (i = 0; i < h + k - 1; i++)
+    for (j = 0; j < w + k - 1; j++)
+      in[i][j] = (DATA_TYPE) ((313*i+991*j) % 256) / 255;
+  for (i = 0; i < k; i++)
+    for (j = 0; j < k; j++)
+      filter[i][j] = (DATA_TYPE) (i + j + 1) / (k * k * k);
+  for (i = 0; i < h; i++)
+    for (j = 0; j < w; j++)
+      out[i][j] = 0;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int h, int w,
+		 DATA_TYPE POLYBENCH_2D(out,H,W,h,w))
+{
+  int i, j;
+
+  for (i = 0; i < h; i++)
+    for (j = 0; j < w; j++) {
+      fprintf(stderr, DATA_PRINTF_MODIFIER, out[i][j]);
+      if ((i * w + j) % 20 == 0) fprintf(stderr, "\n");
+    }
+  fprintf(stderr, "\n");
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_conv_2d(int h, int w, int k,
+		    DATA_TYPE POLYBENCH_2D(in,H+K-1,W+K-1,h+k-1,w+k-1),
+		    DATA_TYPE POLYBENCH_2D(filter,K,K,k,k),
+		    DATA_TYPE POLYBENCH_2D(out,H,W,h,w))
+{
+  int i, j, p, q;
+
+#pragma scop
+  for (i = 0; i < h; i++)
+    for (j = 0; j < w; j++)
+      for (p = 0; p < k; p++)
+	for (q = 0; q < k; q++)
+	  out[i][j] += filter[p][q] * in[i+p][j+q];
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int h = H;
+  int w = W;
+  int k = K;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_2D_ARRAY_DECL(in, DATA_TYPE, H+K-1, W+K-1, h+k-1, w+k-1);
+  POLYBENCH_2D_ARRAY_DECL(filter, DATA_TYPE, K, K, k, k);
+  POLYBENCH_2D_ARRAY_DECL(out, DATA_TYPE, H, W, h, w);
+
+
+  /* Initialize array(s). */
+  init_array (h, w, k, POLYBENCH_ARRAY(in), POLYBENCH_ARRAY(filter),
+	      POLYBENCH_ARRAY(out));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_conv_2d (h, w, k, POLYBENCH_ARRAY(in), POLYBENCH_ARRAY(filter),
+		  POLYBENCH_ARRAY(out));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(h, w, POLYBENCH_ARRAY(out)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(in);
+  POLYBENCH_FREE_ARRAY(filter);
+  POLYBENCH_FREE_ARRAY(out);
+
+  return 0;
+}
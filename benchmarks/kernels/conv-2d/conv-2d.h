@@ -0,0 +1,55 @@
+/**
+ * conv-2d.h: A 2D convolution of an image with a square filter, as in
+ * image processing and the layers of convolutional networks,
+ * in the layout of a PolyBench 3.1 benchmark.
+ */
+#ifndef CONV_2D_H
+# define CONV_2D_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(H) && !defined(W) && !defined(K)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define H 32
+#   define W 32
+#   define K 3
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define H 128
+#   define W 128
+#   define K 3
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define H 1024
+#   define W 1024
+#   define K 5
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define H 2000
+#   define W 2000
+#   define K 7
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define H 4000
+#   define W 4000
+#   define K 7
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+
+#endif /* !CONV_2D */
@@ -1,17 +1,11 @@
 #include <stdio.h>
-#include <stdlib.h>
 #include <unistd.h>
-#include <assert.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sched.h>
 #include <math.h>
 
-#ifndef POLYBENCH_CACHE_SIZE_KB
-# define POLYBENCH_CACHE_SIZE_KB 8192
-#endif
-
 /* Timer code (gettimeofday). */
 double polybench_t_start, polybench_t_end;
 
@@ -28,18 +22,6 @@ double rtclock()
     return (Tp.tv_sec + Tp.tv_usec * 1.0e-6);
 }
 
-inline
-void polybench_flush_cache()
-{
-  int cs = POLYBENCH_CACHE_SIZE_KB * 1024 / sizeof(double);
-  double* flush = (double*) calloc(cs, sizeof(double));
-  int i;
-  double tmp = 0.0;
-  for (i = 0; i < cs; i++)
-    tmp += flush[i];
-  assert (tmp <= 10.0);
-}
-
 #ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
 inline
 void polybench_linux_fifo_scheduler()
@@ -61,11 +43,10 @@ void polybench_linux_standard_scheduler()
 }
 #endif
 
+/* Times without flushing the caches. Use polybench.c for timed runs after
+   a flush sized from the detected last level cache. */
 void polybench_timer_start()
 {
-#ifndef POLYBENCH_NO_FLUSH_CACHE
-  polybench_flush_cache();
-#endif
 #ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
   polybench_linux_fifo_scheduler();
 #endif
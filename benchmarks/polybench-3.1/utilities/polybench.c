@@ -15,6 +15,10 @@
 #include <sys/resource.h>
 #include <sched.h>
 #include <math.h>
+#include <sys/mman.h>
+#ifdef __linux__
+# include <sys/syscall.h>
+#endif
 #ifdef _OPENMP
 # include <omp.h>
 #endif
@@ -24,15 +28,22 @@
 # define POLYBENCH_THREAD_MONITOR 0
 #endif
 
-/* Total LLC cache size. By default 32+MB.. */
-#ifndef POLYBENCH_CACHE_SIZE_KB
-# define POLYBENCH_CACHE_SIZE_KB 32770
-#endif
+/* Total LLC cache size, detected unless defined (see
+   polybench_get_cache_size). By default 32+MB.. */
+#define POLYBENCH_DEFAULT_CACHE_SIZE_KB 32770
 
 
 int polybench_papi_counters_threadid = POLYBENCH_THREAD_MONITOR;
 double polybench_program_total_flops = 0;
 
+#ifdef POLYBENCH_PERF
+# include <errno.h>
+# include <stdint.h>
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+#endif
+
 #ifdef POLYBENCH_PAPI
 # include <papi.h>
 # define POLYBENCH_MAX_NB_PAPI_COUNTERS 96
@@ -83,19 +94,172 @@ unsigned long long int rdtsc()
   return ret;
 }
 
+/* Arrays allocated by polybench_alloc_data: read before the kernel in the
+   warm cache mode, and with POLYBENCH_REPEAT saved after their
+   initialization and restored before every repeated run of the kernel, so
+   that each run starts from the same inputs. Arrays allocated with mmap
+   keep their mapping to unmap it. */
+struct polybench_data
+{
+  void* ptr;
+  size_t size;
+  void* saved;
+  void* map;
+  size_t map_size;
+};
+
+static struct polybench_data* polybench_datas = NULL;
+static int polybench_nb_datas = 0;
+
+
+/* Allocation policy of polybench_alloc_data, from the environment:
+   - $POLYBENCH_ALIGN: alignment of the arrays in bytes, a power of two
+     (default 32), e.g. 64 for cache lines or 2097152 for huge pages
+   - $POLYBENCH_PAGES: "default" for the system's page policy, "thp" to
+     advise transparent huge pages (madvise MADV_HUGEPAGE), or "hugetlb"
+     for explicit huge pages (mmap MAP_HUGETLB, reserved through
+     /proc/sys/vm/nr_hugepages), which falls back to "thp" when none are
+     free
+   - $POLYBENCH_NUMA: "first-touch" (default) to place each page on the
+     node of the thread that first writes it, or "interleave" to spread
+     the pages over every node (mbind MPOL_INTERLEAVE, Linux)
+   Arrays of the default policies are allocated with posix_memalign, the
+   others with mmap so that their pages are fresh. The policy in effect is
+   printed with the times. */
+#define POLYBENCH_DEFAULT_ALIGNMENT 32
+#define POLYBENCH_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define POLYBENCH_MPOL_INTERLEAVE 3
+
+struct polybench_alloc_policy
+{
+  size_t alignment;
+  char pages[16];
+  char numa[16];
+};
+
+static struct polybench_alloc_policy polybench_alloc_policy;
+static int polybench_alloc_policy_read = 0;
+
+
+/* Sum of the flushed or warmed data, so that its reads are kept. */
+volatile double polybench_cache_sink;
+
+
+/* Size of the last level cache in bytes: POLYBENCH_CACHE_SIZE_KB when it
+   is defined, else sysconf when the C library knows it, else the largest
+   cache of CPU 0 in sysfs (Linux). */
+static
+size_t polybench_get_cache_size()
+{
+  static size_t cache_size = 0;
+  size_t largest = 0;
+  char path[128];
+  int index;
+  if (cache_size)
+    return cache_size;
+
+#ifdef POLYBENCH_CACHE_SIZE_KB
+  cache_size = (size_t) POLYBENCH_CACHE_SIZE_KB * 1024;
+#endif
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  if (! cache_size && sysconf (_SC_LEVEL3_CACHE_SIZE) > 0)
+    cache_size = sysconf (_SC_LEVEL3_CACHE_SIZE);
+#endif
+  for (index = 0; ! cache_size && index < 8; index++)
+    {
+      FILE* file;
+      unsigned long size = 0;
+      char unit = 0;
+      sprintf (path, "/sys/devices/system/cpu/cpu0/cache/index%d/size",
+	       index);
+      file = fopen (path, "r");
+      if (! file)
+	break;
+      if (fscanf (file, "%lu%c", &size, &unit) >= 1)
+	{
+	  if (unit == 'K')
+	    size *= 1024;
+	  else if (unit == 'M')
+	    size *= 1024 * 1024;
+	  if (size > largest)
+	    largest = size;
+	}
+      fclose (file);
+    }
+  if (! cache_size)
+    cache_size = largest;
+  if (! cache_size)
+    cache_size = (size_t) POLYBENCH_DEFAULT_CACHE_SIZE_KB * 1024;
+  return cache_size;
+}
+
+
+/* Evicts the arrays from the caches by writing, then reading, a buffer
+   twice the size of the last level cache. Writing makes the buffer's pages
+   distinct (a calloc'ed buffer that is only read may map every page to the
+   zero page) and replaces dirty lines of the arrays. The buffer is kept
+   for the next flush. */
 void polybench_flush_cache()
 {
-  int cs = POLYBENCH_CACHE_SIZE_KB * 1024 / sizeof(double);
-  double* flush = (double*) calloc (cs, sizeof(double));
-  int i;
+  static double* flush = NULL;
+  size_t cs = 2 * polybench_get_cache_size () / sizeof(double);
+  size_t i;
   double tmp = 0.0;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
+  if (! flush)
+    {
+      flush = (double*) malloc (cs * sizeof(double));
+      if (! flush)
+	{
+	  fprintf (stderr, "[PolyBench] malloc: cannot allocate memory");
+	  exit (1);
+	}
+    }
+  for (i = 0; i < cs; i++)
+    flush[i] = (double) i;
   for (i = 0; i < cs; i++)
     tmp += flush[i];
-  assert (tmp <= 10.0);
-  free (flush);
+  polybench_cache_sink = tmp;
+}
+
+
+/* Loads the arrays into the caches, as far as they fit, by reading every
+   cache line of them. */
+static
+void polybench_warm_cache()
+{
+  char tmp = 0;
+  size_t j;
+  int i;
+  for (i = 0; i < polybench_nb_datas; i++)
+    for (j = 0; j < polybench_datas[i].size; j += 64)
+      tmp ^= ((char*) polybench_datas[i].ptr)[j];
+  polybench_cache_sink = tmp;
+}
+
+
+/* Returns 1 to measure the kernel with warm caches, with its arrays loaded
+   instead of flushed, when $POLYBENCH_CACHE is "warm". The default is
+   "cold", or "warm" with POLYBENCH_NO_FLUSH_CACHE. */
+static
+int polybench_is_cache_warm()
+{
+  static int warned = 0;
+  const char* mode = getenv ("POLYBENCH_CACHE");
+  if (mode && ! strcmp (mode, "warm"))
+    return 1;
+  if (mode && ! strcmp (mode, "cold"))
+    return 0;
+  if (mode && *mode && ! warned)
+    {
+      fprintf (stderr, "[PolyBench][WARNING] Unknown POLYBENCH_CACHE=%s\n",
+	       mode);
+      warned = 1;
+    }
+#ifdef POLYBENCH_NO_FLUSH_CACHE
+  return 1;
+#else
+  return 0;
+#endif
 }
 
 
@@ -119,6 +283,159 @@ void polybench_linux_standard_scheduler()
 }
 #endif
 
+
+/* Noise estimate of a timed run: the preemptions of the program by other
+   tasks (involuntary context switches), its migrations to another CPU, and
+   the fraction of the time the SMT siblings of its CPU were busy, since
+   they share its core. Printed with the time as [PolyBench][noise]. */
+static long polybench_noise_nivcsw;
+static int polybench_noise_cpu;
+static long long polybench_noise_nr_migrations;
+static long long polybench_noise_sibling_busy;
+static long long polybench_noise_sibling_total;
+static long polybench_noise_preemptions;
+static long long polybench_noise_migrations;
+static double polybench_noise_sibling_load;
+
+
+static
+int polybench_get_cpu()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned int cpu = 0;
+  if (syscall (SYS_getcpu, &cpu, NULL, NULL) == 0)
+    return cpu;
+#endif
+  return -1;
+}
+
+
+/* Returns the number of times the scheduler moved the program to another
+   CPU, from /proc/self/sched, or -1 if the kernel does not report it. */
+static
+long long polybench_read_migrations()
+{
+  char line[256];
+  long long migrations = -1;
+  FILE* file = fopen ("/proc/self/sched", "r");
+  if (! file)
+    return -1;
+  while (fgets (line, sizeof(line), file))
+    if (sscanf (line, "se.nr_migrations : %lld", &migrations) == 1)
+      break;
+  fclose (file);
+  return migrations;
+}
+
+
+/* Returns 1 if cpu is in a sysfs CPU list, e.g. "0-3,8". */
+static
+int polybench_in_cpu_list(const char* list, int cpu)
+{
+  int first, last, n;
+  while (sscanf (list, "%d%n", &first, &n) == 1)
+    {
+      list += n;
+      last = first;
+      if (*list == '-' && sscanf (list + 1, "%d%n", &last, &n) == 1)
+	list += 1 + n;
+      if (cpu >= first && cpu <= last)
+	return 1;
+      if (*list != ',')
+	break;
+      list++;
+    }
+  return 0;
+}
+
+
+/* Sums the busy and total ticks of the SMT siblings of cpu in
+   /proc/stat. */
+static
+void polybench_read_sibling_times(int cpu, long long* busy, long long* total)
+{
+  char line[512];
+  char list[256] = "";
+  long long v[8];
+  FILE* file;
+  int n, i;
+  *busy = 0;
+  *total = 0;
+  if (cpu < 0)
+    return;
+  sprintf (line, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list",
+	   cpu);
+  file = fopen (line, "r");
+  if (! file)
+    return;
+  if (! fgets (list, sizeof(list), file))
+    list[0] = '\0';
+  fclose (file);
+
+  file = fopen ("/proc/stat", "r");
+  if (! file)
+    return;
+  while (fgets (line, sizeof(line), file))
+    {
+      /* user nice system idle iowait irq softirq steal */
+      memset (v, 0, sizeof(v));
+      if (strncmp (line, "cpu", 3) || line[3] < '0' || line[3] > '9'
+	  || sscanf (line + 3, "%d %lld %lld %lld %lld %lld %lld %lld %lld",
+		     &n, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6],
+		     &v[7]) < 5
+	  || n == cpu || ! polybench_in_cpu_list (list, n))
+	continue;
+      for (i = 0; i < 8; i++)
+	*total += v[i];
+      *busy += v[0] + v[1] + v[2] + v[5] + v[6] + v[7];
+    }
+  fclose (file);
+}
+
+
+static
+void polybench_noise_start()
+{
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  polybench_noise_nivcsw = usage.ru_nivcsw;
+  polybench_noise_cpu = polybench_get_cpu ();
+  polybench_noise_nr_migrations = polybench_read_migrations ();
+  polybench_read_sibling_times (polybench_noise_cpu,
+				&polybench_noise_sibling_busy,
+				&polybench_noise_sibling_total);
+}
+
+
+static
+void polybench_noise_stop()
+{
+  struct rusage usage;
+  long long busy, total;
+  long long migrations = polybench_read_migrations ();
+  getrusage (RUSAGE_SELF, &usage);
+  polybench_noise_preemptions = usage.ru_nivcsw - polybench_noise_nivcsw;
+  /* Without the scheduler's count, a move to another CPU that did not
+     come back is all that can be seen */
+  if (migrations >= 0 && polybench_noise_nr_migrations >= 0)
+    polybench_noise_migrations = migrations - polybench_noise_nr_migrations;
+  else
+    polybench_noise_migrations = polybench_get_cpu () != polybench_noise_cpu;
+  polybench_read_sibling_times (polybench_noise_cpu, &busy, &total);
+  total -= polybench_noise_sibling_total;
+  polybench_noise_sibling_load = total > 0
+    ? (double) (busy - polybench_noise_sibling_busy) / total : 0;
+}
+
+
+static
+void polybench_noise_print()
+{
+  fprintf (stderr, "[PolyBench][noise] preemptions=%ld migrations=%lld "
+	   "siblingBusy=%0.3f\n", polybench_noise_preemptions,
+	   polybench_noise_migrations, polybench_noise_sibling_load);
+}
+
 #ifdef POLYBENCH_PAPI
 
 static
@@ -319,11 +636,255 @@ void polybench_papi_print()
 #endif
 /* ! POLYBENCH_PAPI */
 
-void polybench_prepare_instruments()
+static void polybench_region_print();
+static void polybench_config_print();
+static void polybench_read_alloc_policy();
+
+#ifdef POLYBENCH_PERF
+/* Hardware counters read in one group through perf_event_open (Linux), so
+   that a single run of the kernel measures all of them, unlike the PAPI
+   path which runs it once per counter. Names match the counter columns of
+   the tile dataset. Counters the host does not support are left out, and
+   the group only counts the calling thread. */
+struct polybench_perf_event
+{
+  const char* name;
+  unsigned int type;
+  unsigned long long config;
+};
+
+# define POLYBENCH_PERF_CACHE_MISS(cache) \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) \
+   | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static struct polybench_perf_event polybench_perf_events[] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "l1dMisses", PERF_TYPE_HW_CACHE,
+    POLYBENCH_PERF_CACHE_MISS (PERF_COUNT_HW_CACHE_L1D) },
+  /* Generic cache misses are last level cache misses on most CPUs, and
+     more widely supported than the LL cache event. */
+  { "llcMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { "dtlbMisses", PERF_TYPE_HW_CACHE,
+    POLYBENCH_PERF_CACHE_MISS (PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+# define POLYBENCH_PERF_NB_EVENTS \
+  (sizeof (polybench_perf_events) / sizeof (polybench_perf_events[0]))
+
+static int polybench_perf_fds[POLYBENCH_PERF_NB_EVENTS];
+/* Index of each opened event in the group, -1 if it is not counted. */
+static int polybench_perf_slots[POLYBENCH_PERF_NB_EVENTS];
+static int polybench_perf_leader = -1;
+static unsigned long long polybench_perf_values[POLYBENCH_PERF_NB_EVENTS];
+
+static
+int polybench_perf_open(struct polybench_perf_event* event, int group_fd)
+{
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof (attr));
+  attr.size = sizeof (attr);
+  attr.type = event->type;
+  attr.config = event->config;
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+    | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall (__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+
+void polybench_perf_start()
+{
+  unsigned int i;
+  int nb_slots = 0;
+  polybench_perf_leader = -1;
+  for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+    {
+      polybench_perf_fds[i] = polybench_perf_open (&polybench_perf_events[i],
+						   polybench_perf_leader);
+      polybench_perf_slots[i] = polybench_perf_fds[i] >= 0 ? nb_slots++ : -1;
+      if (polybench_perf_leader == -1 && polybench_perf_fds[i] >= 0)
+	polybench_perf_leader = polybench_perf_fds[i];
+    }
+  if (polybench_perf_leader == -1)
+    {
+      /* No PMU (e.g. in a VM) or not permitted by
+	 /proc/sys/kernel/perf_event_paranoid. */
+      fprintf (stderr, "[PolyBench][WARNING] perf_event_open: %s\n",
+	       strerror (errno));
+      return;
+    }
+  ioctl (polybench_perf_leader, PERF_EVENT_IOC_RESET,
+	 PERF_IOC_FLAG_GROUP);
+  ioctl (polybench_perf_leader, PERF_EVENT_IOC_ENABLE,
+	 PERF_IOC_FLAG_GROUP);
+}
+
+
+/* Reads the counts of the group so far into values (0 for the counters
+   that are left out), scaled to the whole run when the group is
+   multiplexed. Returns 0 if the group cannot be read. */
+static
+int polybench_perf_read(unsigned long long* values)
+{
+  /* nr, time enabled, time running, then one value per event. */
+  uint64_t data[3 + POLYBENCH_PERF_NB_EVENTS];
+  unsigned int i;
+  if (polybench_perf_leader == -1
+      || read (polybench_perf_leader, data, sizeof (data)) <= 0
+      || data[2] == 0)
+    return 0;
+  for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+    values[i] = polybench_perf_slots[i] < 0 ? 0 : (unsigned long long)
+      ((double) data[3 + polybench_perf_slots[i]] * data[1] / data[2]);
+  return 1;
+}
+
+
+void polybench_perf_stop()
 {
-#ifndef POLYBENCH_NO_FLUSH_CACHE
-  polybench_flush_cache ();
+  unsigned int i;
+  if (polybench_perf_leader == -1)
+    return;
+  ioctl (polybench_perf_leader, PERF_EVENT_IOC_DISABLE,
+	 PERF_IOC_FLAG_GROUP);
+  if (! polybench_perf_read (polybench_perf_values))
+    {
+      /* The group never ran, e.g. it needs more counters than exist. */
+      fprintf (stderr, "[PolyBench][WARNING] perf counters were not "
+	       "scheduled\n");
+      for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+	polybench_perf_slots[i] = -1;
+    }
+  for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+    if (polybench_perf_fds[i] >= 0)
+      close (polybench_perf_fds[i]);
+  polybench_perf_leader = -1;
+}
+
+
+void polybench_perf_print()
+{
+  unsigned int i;
+  /* Counters go to stderr, stdout only holds the time. */
+  fprintf (stderr, "[PolyBench][perf]");
+  for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+    if (polybench_perf_slots[i] >= 0)
+      fprintf (stderr, " %s=%llu", polybench_perf_events[i].name,
+	       polybench_perf_values[i]);
+  fprintf (stderr, "\n");
+#if !defined(POLYBENCH_TIME) && !defined(POLYBENCH_GFLOPS)
+  polybench_region_print ();
+  polybench_config_print ();
+#endif
+}
+#endif
+/* ! POLYBENCH_PERF */
+
+
+/* Timing region around the tiled loop nest of a variant, whose calls are
+   emitted by the tiling passes with --time-region. Its time (and its
+   counters with POLYBENCH_PERF) are summed over every execution of the
+   region and printed to stderr after the kernel's time, so that the effect
+   of tiling one nest is not diluted by the other nests of the kernel. */
+static double polybench_region_t_start;
+static double polybench_region_seconds;
+static long long polybench_region_executions;
+#ifdef POLYBENCH_PERF
+static unsigned long long
+polybench_region_perf_start[POLYBENCH_PERF_NB_EVENTS];
+static unsigned long long
+polybench_region_perf_values[POLYBENCH_PERF_NB_EVENTS];
+#endif
+
+static
+double polybench_region_clock()
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1.0e-9;
+#else
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+
+void polybench_region_start()
+{
+#ifdef POLYBENCH_PERF
+  polybench_perf_read (polybench_region_perf_start);
+#endif
+  polybench_region_t_start = polybench_region_clock ();
+}
+
+
+void polybench_region_stop()
+{
+#ifdef POLYBENCH_PERF
+  unsigned long long values[POLYBENCH_PERF_NB_EVENTS];
+  unsigned int i;
+#endif
+  polybench_region_seconds += polybench_region_clock ()
+    - polybench_region_t_start;
+  polybench_region_executions++;
+#ifdef POLYBENCH_PERF
+  if (polybench_perf_read (values))
+    for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+      polybench_region_perf_values[i] += values[i]
+	- polybench_region_perf_start[i];
+#endif
+}
+
+
+static
+void polybench_region_print()
+{
+#ifdef POLYBENCH_PERF
+  unsigned int i;
+#endif
+  if (polybench_region_executions == 0)
+    return;
+  fprintf (stderr, "[PolyBench][region] seconds=%0.9f executions=%lld",
+	   polybench_region_seconds, polybench_region_executions);
+#ifdef POLYBENCH_PERF
+  for (i = 0; i < POLYBENCH_PERF_NB_EVENTS; i++)
+    if (polybench_perf_slots[i] >= 0)
+      fprintf (stderr, " %s=%llu", polybench_perf_events[i].name,
+	       polybench_region_perf_values[i]);
+#endif
+  fprintf (stderr, "\n");
+
+  /* Repeated runs report their own region. */
+  polybench_region_seconds = 0;
+  polybench_region_executions = 0;
+#ifdef POLYBENCH_PERF
+  memset (polybench_region_perf_values, 0,
+	  sizeof (polybench_region_perf_values));
 #endif
+}
+
+/* Prints how the kernel was measured, to record with its times. */
+static
+void polybench_config_print()
+{
+  polybench_read_alloc_policy ();
+  fprintf (stderr, "[PolyBench][config] cacheMode=%s allocPolicy=%s/%lu/%s\n",
+	   polybench_is_cache_warm () ? "warm" : "cold",
+	   polybench_alloc_policy.pages,
+	   (unsigned long) polybench_alloc_policy.alignment,
+	   polybench_alloc_policy.numa);
+}
+
+
+void polybench_prepare_instruments()
+{
+  if (polybench_is_cache_warm ())
+    polybench_warm_cache ();
+  else
+    polybench_flush_cache ();
 #ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
   polybench_linux_fifo_scheduler ();
 #endif
@@ -333,6 +894,10 @@ void polybench_prepare_instruments()
 void polybench_timer_start()
 {
   polybench_prepare_instruments ();
+  polybench_noise_start ();
+#ifdef POLYBENCH_PERF
+  polybench_perf_start ();
+#endif
 #ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
   polybench_t_start = rtclock ();
 #else
@@ -348,6 +913,10 @@ void polybench_timer_stop()
 #else
   polybench_c_end = rdtsc ();
 #endif
+#ifdef POLYBENCH_PERF
+  polybench_perf_stop ();
+#endif
+  polybench_noise_stop ();
 #ifdef POLYBENCH_LINUX_FIFO_SCHEDULER
   polybench_linux_standard_scheduler ();
 #endif
@@ -373,16 +942,61 @@ void polybench_timer_print()
       printf ("%Ld\n", polybench_c_end - polybench_c_start);
 # endif
 #endif
+#ifdef POLYBENCH_PERF
+      polybench_perf_print ();
+#endif
+      polybench_region_print ();
+      polybench_noise_print ();
+      polybench_config_print ();
 }
 
 
 
+static
+void polybench_read_alloc_policy()
+{
+  const char* align = getenv ("POLYBENCH_ALIGN");
+  const char* pages = getenv ("POLYBENCH_PAGES");
+  const char* numa = getenv ("POLYBENCH_NUMA");
+  if (polybench_alloc_policy_read)
+    return;
+  polybench_alloc_policy_read = 1;
+
+  polybench_alloc_policy.alignment = POLYBENCH_DEFAULT_ALIGNMENT;
+  if (align && *align)
+    {
+      size_t value = strtoul (align, NULL, 10);
+      if (value >= sizeof(void*) && ! (value & (value - 1)))
+	polybench_alloc_policy.alignment = value;
+      else
+	fprintf (stderr, "[PolyBench][WARNING] Invalid POLYBENCH_ALIGN=%s\n",
+		 align);
+    }
+
+  strcpy (polybench_alloc_policy.pages, "default");
+  if (pages && (! strcmp (pages, "thp") || ! strcmp (pages, "hugetlb")))
+    strcpy (polybench_alloc_policy.pages, pages);
+  else if (pages && *pages && strcmp (pages, "default"))
+    fprintf (stderr, "[PolyBench][WARNING] Unknown POLYBENCH_PAGES=%s\n",
+	     pages);
+
+  strcpy (polybench_alloc_policy.numa, "first-touch");
+  if (numa && ! strcmp (numa, "interleave"))
+    strcpy (polybench_alloc_policy.numa, numa);
+  else if (numa && *numa && strcmp (numa, "first-touch"))
+    fprintf (stderr, "[PolyBench][WARNING] Unknown POLYBENCH_NUMA=%s\n",
+	     numa);
+}
+
+
 static
 void *
 xmalloc (size_t num)
 {
   void* new = NULL;
-  int ret = posix_memalign (&new, 32, num);
+  int ret;
+  polybench_read_alloc_policy ();
+  ret = posix_memalign (&new, polybench_alloc_policy.alignment, num);
   if (! new || ret)
     {
       fprintf (stderr, "[PolyBench] posix_memalign: cannot allocate memory");
@@ -392,9 +1006,199 @@ xmalloc (size_t num)
 }
 
 
+#ifdef MAP_ANONYMOUS
+/* Interleaves the (untouched) pages of an array over the online NUMA
+   nodes. */
+static
+void polybench_interleave_pages(void* ptr, size_t size)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  unsigned long nodemask = 0;
+  int first, last;
+  char separator;
+  FILE* file = fopen ("/sys/devices/system/node/online", "r");
+  /* The node list is a range list, e.g. "0-1,3". */
+  while (file && fscanf (file, "%d", &first) == 1)
+    {
+      last = first;
+      separator = fgetc (file);
+      if (separator == '-' && fscanf (file, "%d", &last) == 1)
+	separator = fgetc (file);
+      for (; first <= last && first < 64; first++)
+	nodemask |= 1UL << first;
+      if (separator != ',')
+	break;
+    }
+  if (file)
+    fclose (file);
+  if (! nodemask)
+    nodemask = 1;
+  if (syscall (SYS_mbind, ptr, size, POLYBENCH_MPOL_INTERLEAVE, &nodemask,
+	       8 * sizeof(nodemask) + 1, 0))
+    fprintf (stderr, "[PolyBench][WARNING] mbind: cannot interleave\n");
+#else
+  fprintf (stderr, "[PolyBench][WARNING] NUMA interleaving needs Linux\n");
+#endif
+}
+
+
+/* Allocates an array with mmap according to the policy, returning its
+   mapping in map and map_size. */
+static
+void* polybench_map_data(size_t size, void** map, size_t* map_size)
+{
+  size_t page = sysconf (_SC_PAGESIZE);
+  size_t alignment;
+  char* ret;
+
+#ifdef MAP_HUGETLB
+  if (! strcmp (polybench_alloc_policy.pages, "hugetlb"))
+    {
+      /* Huge page mappings are aligned to the huge page size. */
+      *map_size = (size + POLYBENCH_HUGE_PAGE_SIZE - 1)
+	/ POLYBENCH_HUGE_PAGE_SIZE * POLYBENCH_HUGE_PAGE_SIZE;
+      *map = mmap (NULL, *map_size, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (*map != MAP_FAILED
+	  && (size_t) *map % polybench_alloc_policy.alignment == 0)
+	{
+	  if (! strcmp (polybench_alloc_policy.numa, "interleave"))
+	    polybench_interleave_pages (*map, *map_size);
+	  return *map;
+	}
+      if (*map != MAP_FAILED)
+	munmap (*map, *map_size);
+    }
+#endif
+  if (! strcmp (polybench_alloc_policy.pages, "hugetlb"))
+    {
+      fprintf (stderr, "[PolyBench][WARNING] No free huge pages, using "
+	       "transparent huge pages\n");
+      strcpy (polybench_alloc_policy.pages, "thp");
+    }
+
+  /* Transparent huge pages only back aligned huge pages. */
+  if (! strcmp (polybench_alloc_policy.pages, "thp")
+      && polybench_alloc_policy.alignment < POLYBENCH_HUGE_PAGE_SIZE)
+    polybench_alloc_policy.alignment = POLYBENCH_HUGE_PAGE_SIZE;
+  alignment = polybench_alloc_policy.alignment;
+  if (alignment < page)
+    alignment = page;
+  *map_size = (size + page - 1) / page * page + alignment - page;
+  *map = mmap (NULL, *map_size, PROT_READ | PROT_WRITE,
+	       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (*map == MAP_FAILED)
+    {
+      fprintf (stderr, "[PolyBench] mmap: cannot allocate memory");
+      exit (1);
+    }
+  ret = (char*) *map + (alignment - (size_t) *map % alignment) % alignment;
+
+#ifdef MADV_HUGEPAGE
+  if (! strcmp (polybench_alloc_policy.pages, "thp"))
+    madvise (ret, (char*) *map + *map_size - ret, MADV_HUGEPAGE);
+#endif
+  if (! strcmp (polybench_alloc_policy.numa, "interleave"))
+    polybench_interleave_pages (ret, (char*) *map + *map_size - ret);
+  return ret;
+}
+#endif
+
+
 void* polybench_alloc_data(int n, int elt_size)
 {
-  void* ret = xmalloc (n * elt_size);
+  size_t size = (size_t) n * elt_size;
+  void* ret = NULL;
+  void* map = NULL;
+  size_t map_size = 0;
+
+  polybench_read_alloc_policy ();
+#ifdef MAP_ANONYMOUS
+  if (strcmp (polybench_alloc_policy.pages, "default")
+      || strcmp (polybench_alloc_policy.numa, "first-touch"))
+    ret = polybench_map_data (size, &map, &map_size);
+  else
+#endif
+    ret = xmalloc (size);
+
+  polybench_datas = (struct polybench_data*)
+    realloc (polybench_datas,
+	     (polybench_nb_datas + 1) * sizeof (struct polybench_data));
+  if (! polybench_datas)
+    {
+      fprintf (stderr, "[PolyBench] realloc: cannot allocate memory");
+      exit (1);
+    }
+  polybench_datas[polybench_nb_datas].ptr = ret;
+  polybench_datas[polybench_nb_datas].size = size;
+  polybench_datas[polybench_nb_datas].saved = NULL;
+  polybench_datas[polybench_nb_datas].map = map;
+  polybench_datas[polybench_nb_datas].map_size = map_size;
+  polybench_nb_datas++;
 
   return ret;
 }
+
+
+void polybench_free_data(void* ptr)
+{
+  int i;
+  for (i = 0; i < polybench_nb_datas; i++)
+    if (polybench_datas[i].ptr == ptr)
+      {
+	if (polybench_datas[i].map)
+	  munmap (polybench_datas[i].map, polybench_datas[i].map_size);
+	else
+	  free (ptr);
+	polybench_datas[i].ptr = NULL;
+	polybench_datas[i].size = 0;
+	return;
+      }
+  free (ptr);
+}
+
+
+#ifdef POLYBENCH_REPEAT
+static int polybench_run = 0;
+
+void polybench_repeat_save()
+{
+  int i;
+  for (i = 0; i < polybench_nb_datas; i++)
+    {
+      polybench_datas[i].saved = xmalloc (polybench_datas[i].size);
+      memcpy (polybench_datas[i].saved, polybench_datas[i].ptr,
+	      polybench_datas[i].size);
+    }
+  polybench_run = 0;
+}
+
+
+/* Returns 1 while the kernel has runs left, restoring the arrays before
+   every run but the first. The number of runs is POLYBENCH_REPEAT, or the
+   POLYBENCH_REPEAT environment variable when it is set. */
+int polybench_repeat_next()
+{
+  int i;
+  int nb_runs = POLYBENCH_REPEAT;
+  const char* env = getenv ("POLYBENCH_REPEAT");
+  if (env && atoi (env) > 0)
+    nb_runs = atoi (env);
+
+  if (polybench_run >= nb_runs)
+    {
+      for (i = 0; i < polybench_nb_datas; i++)
+	{
+	  free (polybench_datas[i].saved);
+	  polybench_datas[i].saved = NULL;
+	}
+      return 0;
+    }
+  if (polybench_run > 0)
+    for (i = 0; i < polybench_nb_datas; i++)
+      memcpy (polybench_datas[i].ptr, polybench_datas[i].saved,
+	      polybench_datas[i].size);
+  polybench_run++;
+  return 1;
+}
+#endif
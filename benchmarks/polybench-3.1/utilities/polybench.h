@@ -16,6 +16,20 @@
  *   OR (exclusive):
  * -DPOLYBENCH_PAPI, to use PAPI H/W counters (defined in polybench.c)
  *
+ * -DPOLYBENCH_PERF, to also read H/W counters through perf_event_open
+ *   (Linux) in the same run, printed to stderr
+ *
+ * -DPOLYBENCH_REPEAT=K, to run the kernel K times in one process (or
+ *   $POLYBENCH_REPEAT times), restoring its arrays between runs
+ *
+ * The caches are flushed before the kernel (sized from the detected last
+ * level cache), or warmed with its arrays when $POLYBENCH_CACHE is "warm"
+ * or with -DPOLYBENCH_NO_FLUSH_CACHE
+ *
+ * Arrays are allocated with the alignment, page size and NUMA placement
+ * of $POLYBENCH_ALIGN, $POLYBENCH_PAGES and $POLYBENCH_NUMA (see
+ * polybench_alloc_data in utilities/polybench.c)
+ *
  *
  * See README or utilities/polybench.c for additional options.
  *
@@ -48,7 +62,7 @@
 */
 # ifndef POLYBENCH_STACK_ARRAYS
 #  define POLYBENCH_ARRAY(x) *x
-#  define POLYBENCH_FREE_ARRAY(x) free((void*)x);
+#  define POLYBENCH_FREE_ARRAY(x) polybench_free_data((void*)x);
 #  define POLYBENCH_DECL_VAR(x) (*x)
 # else
 #  define POLYBENCH_ARRAY(x) x
@@ -168,6 +182,49 @@ extern void polybench_timer_stop();
 extern void polybench_timer_print();
 # endif
 
+/* perf_event_open counters, alone or in the same run as the timer. */
+# ifdef POLYBENCH_PERF
+#  if !defined(POLYBENCH_TIME) && !defined(POLYBENCH_GFLOPS)
+#   undef polybench_start_instruments
+#   undef polybench_stop_instruments
+#   undef polybench_print_instruments
+#   define polybench_start_instruments \
+  polybench_prepare_instruments(); polybench_perf_start();
+#   define polybench_stop_instruments polybench_perf_stop();
+#   define polybench_print_instruments polybench_perf_print();
+#  endif
+extern void polybench_prepare_instruments();
+extern void polybench_perf_start();
+extern void polybench_perf_stop();
+extern void polybench_perf_print();
+# endif
+
+/* Repeated runs of the kernel in one process, printing the time (and
+   counters) of each run. The arrays allocated with polybench_alloc_data are
+   restored to their initial values before each run, and the cache is
+   flushed as before any timed run. Requires POLYBENCH_TIME or
+   POLYBENCH_GFLOPS, and heap arrays. */
+# if defined(POLYBENCH_REPEAT) \
+  && (defined(POLYBENCH_TIME) || defined(POLYBENCH_GFLOPS))
+#  undef polybench_start_instruments
+#  undef polybench_stop_instruments
+#  undef polybench_print_instruments
+#  define polybench_start_instruments		\
+  polybench_repeat_save();			\
+  while (polybench_repeat_next())		\
+    {						\
+      polybench_timer_start();
+
+#  define polybench_stop_instruments		\
+      polybench_timer_stop();			\
+      polybench_timer_print();			\
+    }
+
+#  define polybench_print_instruments
+extern void polybench_repeat_save();
+extern int polybench_repeat_next();
+# endif
+
 /* Function declaration. */
 # ifdef POLYBENCH_TIME
 extern void polybench_timer_start();
@@ -186,6 +243,9 @@ extern void polybench_papi_print();
 
 /* Function prototypes. */
 extern void* polybench_alloc_data(int n, int elt_size);
+extern void polybench_free_data(void* ptr);
+extern void polybench_region_start();
+extern void polybench_region_stop();
 
 
 #endif /* !POLYBENCH_H */
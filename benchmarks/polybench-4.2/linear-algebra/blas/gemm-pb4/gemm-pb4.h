@@ -0,0 +1,59 @@
+/**
+ * gemm-pb4.h: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness, and renamed to keep the variants of 3.1's
+ * gemm apart. The MEDIUM dataset is STANDARD_DATASET.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#ifndef GEMM_PB4_H
+# define GEMM_PB4_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(NI) && !defined(NJ) && !defined(NK)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define NI 20
+#   define NJ 25
+#   define NK 30
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define NI 60
+#   define NJ 70
+#   define NK 80
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define NI 200
+#   define NJ 220
+#   define NK 240
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define NI 1000
+#   define NJ 1100
+#   define NK 1200
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define NI 2000
+#   define NJ 2300
+#   define NK 2600
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+
+#endif /* !GEMM_PB4 */
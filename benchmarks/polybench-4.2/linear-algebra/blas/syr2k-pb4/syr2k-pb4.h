@@ -0,0 +1,54 @@
+/**
+ * syr2k-pb4.h: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness, and renamed to keep the variants of 3.1's
+ * syr2k apart. The MEDIUM dataset is STANDARD_DATASET.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#ifndef SYR2K_PB4_H
+# define SYR2K_PB4_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(M) && !defined(N)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define M 20
+#   define N 30
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define M 60
+#   define N 80
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define M 200
+#   define N 240
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define M 1000
+#   define N 1200
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define M 2000
+#   define N 2600
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+
+#endif /* !SYR2K_PB4 */
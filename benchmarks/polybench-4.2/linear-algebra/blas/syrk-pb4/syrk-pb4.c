@@ -0,0 +1,120 @@
+/**
+ * syrk-pb4.c: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness. Unlike 3.1's syrk, only the lower triangle
+ * of C is updated, with the k loop outside the j loop.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+/* Default data type is double, default size is 200x240. */
+#include "syrk-pb4.h"
+
+
+/* Array initialization. */
+static
+void init_array(int n, int m,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,N,N,n,n),
+		DATA_TYPE POLYBENCH_2D(A,N,M,n,m))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < m; j++)
+      A[i][j] = (DATA_TYPE) ((i*j+1)%n) / n;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      C[i][j] = (DATA_TYPE) ((i*j+2)%m) / m;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
+{
+  int i, j;
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++) {
+	fprintf (stderr, DATA_PRINTF_MODIFIER, C[i][j]);
+	if ((i * n + j) % 20 == 0) fprintf (stderr, "\n");
+    }
+  fprintf (stderr, "\n");
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_syrk_pb4(int n, int m,
+		     DATA_TYPE alpha,
+		     DATA_TYPE beta,
+		     DATA_TYPE POLYBENCH_2D(C,N,N,n,n),
+		     DATA_TYPE POLYBENCH_2D(A,N,M,n,m))
+{
+  int i, j, k;
+
+#pragma scop
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j <= i; j++)
+	C[i][j] *= beta;
+      for (k = 0; k < m; k++)
+	for (j = 0; j <= i; j++)
+	  C[i][j] += alpha * A[i][k] * A[j][k];
+    }
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+  int m = M;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,N,N,n,n);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,N,M,n,m);
+
+  /* Initialize array(s). */
+  init_array (n, m, &alpha, &beta, POLYBENCH_ARRAY(C), POLYBENCH_ARRAY(A));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_syrk_pb4 (n, m, alpha, beta, POLYBENCH_ARRAY(C), POLYBENCH_ARRAY(A));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * deriche.h: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness. The MEDIUM dataset is STANDARD_DATASET.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#ifndef DERICHE_H
+# define DERICHE_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(W) && !defined(H)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define W 64
+#   define H 64
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define W 192
+#   define H 128
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define W 720
+#   define H 480
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define W 4096
+#   define H 2160
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define W 7680
+#   define H 4320
+#  endif
+# endif /* !N */
+
+
+/* Images are single precision, as in PolyBench/C 4.2. */
+# ifndef DATA_TYPE
+#  define DATA_TYPE float
+#  define DATA_PRINTF_MODIFIER "%0.2f "
+#  define EXP_FUN(x) expf(x)
+#  define POW_FUN(x,y) powf(x,y)
+# endif
+
+# ifndef EXP_FUN
+#  define EXP_FUN(x) exp(x)
+#  define POW_FUN(x,y) pow(x,y)
+# endif
+
+
+#endif /* !DERICHE */
@@ -0,0 +1,51 @@
+/**
+ * nussinov.h: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness. The MEDIUM dataset is STANDARD_DATASET.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#ifndef NUSSINOV_H
+# define NUSSINOV_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(N)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define N 60
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define N 180
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define N 500
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define N 2500
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define N 5500
+#  endif
+# endif /* !N */
+
+
+/* Scores are integers, and bases are 0 to 3 for A, C, G and U. */
+# ifndef DATA_TYPE
+#  define DATA_TYPE int
+#  define DATA_PRINTF_MODIFIER "%d "
+# endif
+
+typedef char base;
+
+
+#endif /* !NUSSINOV */
@@ -0,0 +1,122 @@
+/**
+ * heat-3d.c: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+/* Default data type is double, default size is 100x40x40x40. */
+#include "heat-3d.h"
+
+
+/* Array initialization. */
+static
+void init_array (int n,
+		 DATA_TYPE POLYBENCH_3D(A,N,N,N,n,n,n),
+		 DATA_TYPE POLYBENCH_3D(B,N,N,N,n,n,n))
+{
+  int i, j, k;
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      for (k = 0; k < n; k++)
+	A[i][j][k] = B[i][j][k] = (DATA_TYPE) (i + j + (n-k)) * 10 / n;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_3D(A,N,N,N,n,n,n))
+
+{
+  int i, j, k;
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      for (k = 0; k < n; k++) {
+	fprintf(stderr, DATA_PRINTF_MODIFIER, A[i][j][k]);
+	if (((i * n + j) * n + k) % 20 == 0) fprintf(stderr, "\n");
+      }
+  fprintf(stderr, "\n");
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_heat_3d(int tsteps,
+		    int n,
+		    DATA_TYPE POLYBENCH_3D(A,N,N,N,n,n,n),
+		    DATA_TYPE POLYBENCH_3D(B,N,N,N,n,n,n))
+{
+  int t, i, j, k;
+
+#pragma scop
+  for (t = 1; t <= tsteps; t++)
+    {
+      for (i = 1; i < n - 1; i++)
+	for (j = 1; j < n - 1; j++)
+	  for (k = 1; k < n - 1; k++)
+	    B[i][j][k] = 0.125 * (A[i+1][j][k] - 2.0 * A[i][j][k] + A[i-1][j][k])
+			 + 0.125 * (A[i][j+1][k] - 2.0 * A[i][j][k] + A[i][j-1][k])
+			 + 0.125 * (A[i][j][k+1] - 2.0 * A[i][j][k] + A[i][j][k-1])
+			 + A[i][j][k];
+      for (i = 1; i < n - 1; i++)
+	for (j = 1; j < n - 1; j++)
+	  for (k = 1; k < n - 1; k++)
+	    A[i][j][k] = 0.125 * (B[i+1][j][k] - 2.0 * B[i][j][k] + B[i-1][j][k])
+			 + 0.125 * (B[i][j+1][k] - 2.0 * B[i][j][k] + B[i][j-1][k])
+			 + 0.125 * (B[i][j][k+1] - 2.0 * B[i][j][k] + B[i][j][k-1])
+			 + B[i][j][k];
+    }
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+  int tsteps = TSTEPS;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_3D_ARRAY_DECL(A, DATA_TYPE, N, N, N, n, n, n);
+  POLYBENCH_3D_ARRAY_DECL(B, DATA_TYPE, N, N, N, n, n, n);
+
+
+  /* Initialize array(s). */
+  init_array (n, POLYBENCH_ARRAY(A), POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_heat_3d (tsteps, n, POLYBENCH_ARRAY(A), POLYBENCH_ARRAY(B));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(A)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+
+  return 0;
+}
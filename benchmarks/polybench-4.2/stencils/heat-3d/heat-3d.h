@@ -0,0 +1,53 @@
+/**
+ * heat-3d.h: This file is part of the PolyBench/C 4.2 test suite, ported
+ * to the PolyBench 3.1 harness. The MEDIUM dataset is STANDARD_DATASET.
+ *
+ *
+ * Contact: Louis-Noel Pouchet <pouchet@cse.ohio-state.edu>
+ * Web address: http://polybench.sourceforge.net
+ */
+#ifndef HEAT_3D_H
+# define HEAT_3D_H
+
+/* Default to STANDARD_DATASET. */
+# if !defined(MINI_DATASET) && !defined(SMALL_DATASET) && !defined(LARGE_DATASET) && !defined(EXTRALARGE_DATASET)
+#  define STANDARD_DATASET
+# endif
+
+/* Do not define anything if the user manually defines the size. */
+# if !defined(TSTEPS) && !defined(N)
+/* Define the possible dataset sizes. */
+#  ifdef MINI_DATASET
+#   define TSTEPS 20
+#   define N 10
+#  endif
+
+#  ifdef SMALL_DATASET
+#   define TSTEPS 40
+#   define N 20
+#  endif
+
+#  ifdef STANDARD_DATASET /* Default if unspecified. */
+#   define TSTEPS 100
+#   define N 40
+#  endif
+
+#  ifdef LARGE_DATASET
+#   define TSTEPS 500
+#   define N 120
+#  endif
+
+#  ifdef EXTRALARGE_DATASET
+#   define TSTEPS 1000
+#   define N 200
+#  endif
+# endif /* !N */
+
+
+# ifndef DATA_TYPE
+#  define DATA_TYPE double
+#  define DATA_PRINTF_MODIFIER "%0.2lf "
+# endif
+
+
+#endif /* !HEAT_3D */
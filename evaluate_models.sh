@@ -0,0 +1,122 @@
+#!/bin/bash
+
+# Held-out evaluation of AutoTile, run after generate_all_tiled_benchmarks.sh
+# and measure_runtimes.sh: for each benchmark with measured loops, a model
+# is trained on every other benchmark (leave-one-benchmark-out), and for
+# each tiled loop the untiled program, AutoTile's output with that model and
+# the fastest measured variant (the oracle) are measured again with the same
+# harness, pinned by RunPinned. Prints a table of runtimes and speedups over
+# the untiled program, and their geometric means over the loops.
+#
+# Exits with an error when AutoTile's geometric mean speedup is below
+# MIN_SPEEDUP (1 by default), so it can gate a new model. Arguments are
+# passed to TrainTileModel, e.g. --kind=forest. DATASETS, TILE_SIZES,
+# NUM_RUNS, PIN_CPU, ALLOW_BUSY_SIBLINGS and THREADS apply as in the other scripts, and
+# BENCHMARKS can list the sources to evaluate (every benchmark under
+# benchmarks/ by default). Outputs are written to tiled_polybench/eval/
+
+Root=$PWD
+declare -a Datasets=(${DATASETS:-MINI SMALL STANDARD LARGE EXTRALARGE})
+TileSizes=${TILE_SIZES:-1,4,8,16,32,64,128,256}
+NumRuns=${NUM_RUNS:-5}
+Threads=${THREADS:-$(nproc)}
+MinSpeedup=${MIN_SPEEDUP:-1}
+Benchmarks=${BENCHMARKS:-$(find benchmarks -name '*.c' -not -path '*/utilities/*' | sort)}
+Utilities=$Root/benchmarks/polybench-3.1/utilities
+# Same flags as the variants of generate_all_tiled_benchmarks.sh
+Flags="-lm -DPOLYBENCH_TIME -DPOLYBENCH_PERF -DPOLYBENCH_REPEAT=5"
+
+cd tiled_polybench
+EvalDir=$PWD/eval
+rm -rf $EvalDir
+mkdir -p $EvalDir/models $EvalDir/work
+
+Pin="../RunPinned ${PIN_CPU:+--cpu=$PIN_CPU} ${ALLOW_BUSY_SIBLINGS:+--allow-busy-siblings}"
+$Pin true || exit 1
+
+# prints the median of NUM_RUNS runs of a binary, empty if it fails
+measure() {
+  local Runs=""
+  while [ $(echo $Runs | wc -w) -lt $NumRuns ]; do
+    Output=$($Pin ./$1 2> /dev/null)
+    if [ -z "$Output" ]; then
+      break
+    fi
+    Runs="$Runs $Output"
+  done
+  echo $Runs | tr ' ' '\n' | head -$NumRuns | sort -g | awk '{ r[NR] = $1 } END { if (NR) print (NR % 2 ? r[(NR + 1) / 2] : (r[NR / 2] + r[NR / 2 + 1]) / 2) }'
+}
+
+# fastest measured variant of every loop, "{variant} {runtime}"
+Best=$(../TileDatasetTool best-variants dataset.tssd) || exit 1
+
+for path in $Benchmarks; do
+  root=$(basename $path .c)
+  for dataset in ${Datasets[@]}; do
+    # loops of the benchmark tiled without a nest transform, as by AutoTile
+    Oracles=$(echo "$Best" | grep "^$root-${dataset}_" | cut -d' ' -f1)
+    if [ -z "$Oracles" ]; then
+      continue
+    fi
+    echo "Evaluating $path ($dataset dataset)"
+
+    model=$EvalDir/models/$root.tssm
+    if [ ! -f $model ]; then
+      ../TrainTileModel --threads=$Threads --validation=none --exclude=$root "$@" dataset.tssd $model > /dev/null || exit 1
+    fi
+
+    workDir=$EvalDir/work/$dataset-$root
+    mkdir -p $workDir
+    (cd $workDir && $Root/AutoTile -I$Utilities $Utilities/polybench.c $Root/$path $Flags -D${dataset}_DATASET --model=$model --prediction-cache= --tile-sizes=$TileSizes --time-region=1 --dataset=$EvalDir/autotile.tssd --output-dir=$EvalDir)
+    rm -rf $workDir
+
+    baseline=eval/$root-$dataset.out
+    ${CC:-gcc} -I$Utilities $Utilities/polybench.c $Root/$path $Flags -D${dataset}_DATASET -o $baseline || exit 1
+    BaselineTime=$(measure $baseline)
+
+    for oracle in $Oracles; do
+      loopId=${oracle%_*}
+      if [ ! -x $oracle.out ]; then
+        echo "Skipping $loopId, $oracle.out is missing"
+        continue
+      fi
+      # a loop AutoTile does not tile runs as in the untiled program
+      predicted=$(cd eval && ls ${loopId}_*.out 2> /dev/null | head -1)
+      if [ -n "$predicted" ]; then
+        PredictedSize=$(basename ${predicted##*_} .out)
+        PredictedTime=$(measure eval/$predicted)
+      else
+        PredictedSize=0
+        PredictedTime=$BaselineTime
+      fi
+      OracleTime=$(measure $oracle.out)
+      if [ -n "$BaselineTime" ] && [ -n "$PredictedTime" ] && [ -n "$OracleTime" ]; then
+        echo "$loopId $BaselineTime $PredictedSize $PredictedTime ${oracle##*_} $OracleTime" >> $EvalDir/report.txt
+      fi
+    done
+  done
+done
+
+if [ ! -s $EvalDir/report.txt ]; then
+  echo "No measured loops to evaluate"
+  exit 1
+fi
+
+awk -v min=$MinSpeedup '
+BEGIN {
+  printf "%-40s %10s %6s %10s %8s %6s %10s %8s\n", "loop", "untiled", "size", "AutoTile", "speedup", "size", "oracle", "speedup"
+}
+{
+  printf "%-40s %10.6f %6d %10.6f %8.3f %6d %10.6f %8.3f\n", $1, $2, $3, $4, $2 / $4, $5, $6, $2 / $6
+  predicted += log($2 / $4)
+  oracle += log($2 / $6)
+  n++
+}
+END {
+  printf "\nGeometric mean speedup over untiled, %d loops: AutoTile %.3f, oracle %.3f (AutoTile reaches %.3f of the oracle)\n", n, exp(predicted / n), exp(oracle / n), exp((predicted - oracle) / n)
+  if (exp(predicted / n) < min) {
+    printf "AutoTile speedup is below MIN_SPEEDUP=%s\n", min
+    exit 1
+  }
+}' $EvalDir/report.txt | tee $EvalDir/report.log
+exit ${PIPESTATUS[0]}
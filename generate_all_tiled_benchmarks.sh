@@ -37,11 +37,66 @@ declare -a StringArray=(
 "../benchmarks/polybench-3.1/medley/floyd-warshall/floyd-warshall.c"
 "../benchmarks/polybench-3.1/datamining/correlation/correlation.c"
 "../benchmarks/polybench-3.1/datamining/covariance/covariance.c"
+"../benchmarks/polybench-4.2/linear-algebra/blas/gemm-pb4/gemm-pb4.c"
+"../benchmarks/polybench-4.2/linear-algebra/blas/syrk-pb4/syrk-pb4.c"
+"../benchmarks/polybench-4.2/linear-algebra/blas/syr2k-pb4/syr2k-pb4.c"
+"../benchmarks/polybench-4.2/stencils/heat-3d/heat-3d.c"
+"../benchmarks/polybench-4.2/medley/deriche/deriche.c"
+"../benchmarks/polybench-4.2/medley/nussinov/nussinov.c"
+"../benchmarks/kernels/batched-gemm/batched-gemm.c"
+"../benchmarks/kernels/conv-2d/conv-2d.c"
+"../benchmarks/kernels/bspmv/bspmv.c"
 )
 
-for path in ${StringArray[@]}; do
-  echo "Starting generation for $path"
+# Additional benchmarks, with paths relative to the repository, e.g. the
+# kernels of GenerateSyntheticKernels: EXTRA_BENCHMARKS="$(cat synth.txt)"
+for path in ${EXTRA_BENCHMARKS}; do
+  StringArray+=("../$path")
+done
+
+# PolyBench dataset sizes to sweep, override with e.g. DATASETS="SMALL LARGE"
+declare -a Datasets=(${DATASETS:-MINI SMALL STANDARD LARGE EXTRALARGE})
+
+# Nest transforms to search besides plain tiling, see README
+NestTransforms=${NEST_TRANSFORMS:-none,distribute,fuse}
+
+# Number of generator processes to run at once, override with e.g. JOBS=8.
+# Each process works in its own directory under work/ since ROSE writes its
+# outputs to the working directory, and all of them append to dataset.tssd.
+# An interrupted sweep can be rerun and skips the variants already recorded
+Jobs=${JOBS:-1}
+
+# Tile sizes to generate for each loop, see TileSearchSpace.h. Override with
+# e.g. TILE_SIZES="pow2:2-256,24-40:4", or TILE_SIZES=@$PWD/sizes.txt for a
+# file (with an absolute path, generators run in their own directories)
+TileSizes=${TILE_SIZES:-1,4,8,16,32,64,128,256}
+
+# File of output names to restrict the sweep to, e.g. the variants chosen
+# by autotune.sh (with an absolute path), all variants are generated if unset
+Variants=${VARIANTS:+--variants=$VARIANTS}
+
+# Cache of generated variants shared by all sweeps, see README. Set
+# VARIANT_CACHE to another directory to share it between output directories
+VariantCache=${VARIANT_CACHE:-$PWD/variant_cache}
+
+generate() {
+  local dataset=$1
+  local path=$2
+  local workDir=work/${dataset}-$(basename $path .c)
+  mkdir -p $workDir
+  echo "Starting generation for $path ($dataset dataset)"
   SECONDS=0
-  ../GenerateTiledBenchmarks -I../benchmarks/polybench-3.1/utilities ../benchmarks/polybench-3.1/utilities/polybench.c $path -lm -DPOLYBENCH_TIME
-  echo "- finished in $SECONDS seconds"
+  (cd $workDir && ../../../GenerateTiledBenchmarks -I../../../benchmarks/polybench-3.1/utilities ../../../benchmarks/polybench-3.1/utilities/polybench.c ../../$path -lm -DPOLYBENCH_TIME -DPOLYBENCH_PERF -DPOLYBENCH_REPEAT=5 -D${dataset}_DATASET --nest-transforms=$NestTransforms --tile-sizes=$TileSizes --time-region=1 --dataset=../../dataset.tssd --output-dir=../.. --variant-cache=$VariantCache $Variants)
+  echo "- finished $path ($dataset dataset) in $SECONDS seconds"
+  rm -rf $workDir
+}
+
+for dataset in ${Datasets[@]}; do
+  for path in ${StringArray[@]}; do
+    while [ $(jobs -r | wc -l) -ge $Jobs ]; do
+      wait -n
+    done
+    generate $dataset $path &
+  done
 done
+wait
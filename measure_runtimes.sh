@@ -2,30 +2,70 @@
 
 cd tiled_polybench
 
-# create a .csv file if it doesn't exist
-if [ ! -f runtimes.csv ]; then
-  touch runtimes.csv
-  echo "uniqueFilename,run1,run2,run3,run4,run5" >> runtimes.csv
+# for each generated binary without runtimes, record the runtimes of 5 runs
+# (or NUM_RUNS) in the dataset. Binaries without a dataset record may be
+# incomplete and are skipped. A file of output names (relative to
+# tiled_polybench) can be given to only measure those, as autotune.sh does
+Pending=$(../TileDatasetTool list-pending dataset.tssd)
+if [ -n "$1" ]; then
+  Pending=$(echo "$Pending" | grep -Fx -f "$1")
 fi
+NumRuns=${NUM_RUNS:-5}
 
-# for each binary, output the runtimes of 5 separate runs to a .csv file
-for binary in *.out; do
+# every binary runs pinned to one CPU by RunPinned, by default the least
+# busy core of those allowed. Set PIN_CPU to choose the CPU. RunPinned fails
+# when the SMT siblings of the CPU are busy, set ALLOW_BUSY_SIBLINGS=1 to
+# measure anyway (the siblingBusy noise column then marks the runs). The
+# CPU's governor and turbo state are checked first, with warnings when they
+# make runtimes vary
+Pin="../RunPinned ${PIN_CPU:+--cpu=$PIN_CPU} ${ALLOW_BUSY_SIBLINGS:+--allow-busy-siblings}"
+$Pin true || exit 1
 
-  # check if we already measured this binary
-  if grep -Fq "$binary" runtimes.csv; then
-    echo "Skipping measurement for $binary"
+for name in $Pending; do
+
+  binary=$name.out
+  echo "Starting measurements for $binary"
+  # binaries built with -DPOLYBENCH_REPEAT print the time of every run of
+  # the kernel, so one process may give all of them
+  Runs=""
+  rm -f $name.perf
+  while [ $(echo $Runs | wc -w) -lt $NumRuns ]; do
+    Output=$($Pin ./$binary 2>> $name.perf)
+    if [ -z "$Output" ]; then
+      break
+    fi
+    Runs="$Runs $Output"
+  done
+  # a binary that crashes or prints no time stays pending, its stderr is
+  # kept in $name.err
+  if [ -z "$Runs" ]; then
+    echo "Skipping $binary, it printed no runtime (see $name.err)"
+    mv $name.perf $name.err
     continue
   fi
+  ../TileDatasetTool append-runtimes dataset.tssd "$name" $(echo $Runs | tr ' ' '\n' | head -$NumRuns)
 
-  echo "Starting measurements for $binary"
-  RUN1=$(./$binary)
-  RUN2=$(./$binary)
-  RUN3=$(./$binary)
-  RUN4=$(./$binary)
-  RUN5=$(./$binary)
-  RUN6=$(./$binary)
-  RUN7=$(./$binary)
-  RUN8=$(./$binary)
-  echo "$binary,$RUN1,$RUN2,$RUN3,$RUN4,$RUN5" >> runtimes.csv
+  # hardware counters of the first run (see POLYBENCH_PERF in polybench.c)
+  ../TileDatasetTool append-counters dataset.tssd "$name" $(sed -n 's/^\[PolyBench\]\[perf\]//p' $name.perf | head -1)
+
+  # how the runtimes were measured: the cache mode and array allocation
+  # policy of polybench.c, which binaries take from $POLYBENCH_CACHE,
+  # $POLYBENCH_PAGES, $POLYBENCH_ALIGN and $POLYBENCH_NUMA, and the CPU
+  # the runs were pinned to
+  ../TileDatasetTool append-config dataset.tssd "$name" $(sed -n 's/^\[PolyBench\]\[config\]//p' $name.perf | head -1) $(sed -n 's/^\[PolyBench\]\[host\]//p' $name.perf | head -1)
+
+  # noise estimates of the runs (preemptions, migrations, busy SMT siblings)
+  ../TileDatasetTool append-noise dataset.tssd "$name" $(sed -n 's/^\[PolyBench\]\[noise\]//p' $name.perf | head -$NumRuns)
+
+  # time per execution of the tiled loop nest, for variants generated with
+  # --time-region
+  RegionRuns=$(sed -n 's/^\[PolyBench\]\[region\] seconds=\([^ ]*\) executions=\([^ ]*\).*/\1 \2/p' $name.perf | awk '{ printf "%.9g\n", $1 / $2 }')
+  if [ -n "$RegionRuns" ]; then
+    ../TileDatasetTool append-region-runtimes dataset.tssd "$name" $RegionRuns
+  fi
+  rm -f $name.perf
 
 done 
+
+# convert the dataset for the notebooks
+../TileDatasetTool to-csv dataset.tssd dataset.csv
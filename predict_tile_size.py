@@ -20,37 +20,21 @@ def load_model_from_file(filename):
     with open(filename, 'rb') as file:
         return pickle.load(file)
 
+# Features the original models were trained on, in training order
+LEGACY_FEATURES = ['readInvariant', 'readPrefetched', 'readNonPrefetched',
+                   'writeInvariant', 'writePrefetched', 'writeNonPrefetched',
+                   'distToDominatingLoop']
+
+def parse_feature(arg):
+  name, sep, value = arg.partition('=')
+  if not sep:
+    raise argparse.ArgumentTypeError(
+        "feature '%s' is not of the form name=value" % arg)
+  return name, int(value)
+
 def main():
   parser = argparse.ArgumentParser(
       description='Predicts tile size when given the required loop features.')
-  parser.add_argument(
-      "readInvariant",
-      help="Number of read invariant array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "readPrefetched",
-      help="Number of read prefetched array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "readNonPrefetched",
-      help="Number of read non-prefetched array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "writeInvariant",
-      help="Number of write invariant array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "writePrefetched",
-      help="Number of write prefetched array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "writeNonPrefetched",
-      help="Number of write non-prefetched array references in the dominating loop",
-      type=int)
-  parser.add_argument(
-      "distToDominatingLoop",
-      help="Distance of the tiled loop frmo the dominating loop",
-      type=int)
   parser.add_argument(
       "modelPath",
       help="Path to the trained model",
@@ -59,19 +43,26 @@ def main():
       "outputPath",
       help="Path that the predicted tile size will be written to",
       type=str)
+  parser.add_argument(
+      "features",
+      help="Loop features as name=value pairs (e.g. readPrefetched=2)",
+      type=parse_feature,
+      nargs='*')
 
   args = parser.parse_args()
 
-  input = pd.DataFrame({'readInvariant': [args.readInvariant],
-                        'readPrefetched': [args.readPrefetched],
-                        'readNonPrefetched': [args.readNonPrefetched],
-                        'writeInvariant': [args.writeInvariant],
-                        'writePrefetched': [args.writePrefetched],
-                        'writeNonPrefetched': [args.writeNonPrefetched],
-                        'distToDominatingLoop': [args.distToDominatingLoop]})
+  features = dict(args.features)
+  input = pd.DataFrame({name: [value] for name, value in features.items()})
 
   model = load_model_from_file(args.modelPath)
 
+  # Only pass the features the model was trained on, in the same order
+  columns = list(getattr(model, 'feature_names_in_', LEGACY_FEATURES))
+  missing = [name for name in columns if name not in features]
+  if missing:
+    sys.exit("missing features for model: " + ", ".join(missing))
+  input = input[columns]
+
   prediction = model.predict(input)
   f = open(args.outputPath, "w")
   f.write(str(prediction[0]))
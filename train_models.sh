@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Retrains the native tile size models on every measured loop in
+# tiled_polybench/dataset.tssd, run after measure_runtimes.sh. Training uses
+# every core, override with e.g. THREADS=4. Other TrainTileModel options can
+# be passed as arguments, e.g. --features=... Each model is first
+# cross-validated over the benchmarks, and the slowdown it reaches on the
+# loops of each held out benchmark is printed to compare the models.
+
+Threads=${THREADS:-$(nproc)}
+
+./TrainTileModel --kind=gbt --threads=$Threads "$@" tiled_polybench/dataset.tssd models/boosted_tree.tssm
+./TrainTileModel --kind=forest --threads=$Threads "$@" tiled_polybench/dataset.tssd models/rand_forest.tssm
+./TrainTileModel --kind=gbt --task=runtime --threads=$Threads "$@" tiled_polybench/dataset.tssd models/runtime_gbt.tssm